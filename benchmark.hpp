@@ -0,0 +1,81 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/*******************************************************************************
+  benchmark.hpp : outils minimalistes pour les microbenchmarks. La fonction
+  'measure' exécute plusieurs séries d'appels au foncteur et retourne la durée
+  médiane d'un appel, en nanosecondes. 'keep' empêche le compilateur d'éliminer
+  un résultat qui n'est pas utilisé par ailleurs.
+
+  Les résultats sont écrits une ligne par mesure, en CSV ou en JSON Lines selon
+  'Format', pour pouvoir comparer deux exécutions (par exemple avant et après
+  une modification) avec des outils usuels.
+*******************************************************************************/
+
+namespace bench {
+
+template<typename T>
+inline void keep(T&& value) {
+  asm volatile("" : : "g"(&value) : "memory");
+}
+
+template<typename F>
+double measure(F&& ftor, size_t iterations_nb = 1e4, size_t series_nb = 9) {
+  using clock = std::chrono::steady_clock;
+  std::vector<double> durations;
+
+  for (size_t i = 0; i < iterations_nb / 10 + 1; i++) ftor(); // Echauffement
+  for (size_t i = 0; i < series_nb; i++) {
+    auto begin = clock::now();
+    for (size_t j = 0; j < iterations_nb; j++) ftor();
+    std::chrono::duration<double, std::nano> duration = clock::now() - begin;
+    durations.push_back(duration.count() / iterations_nb);
+  }
+
+  std::ranges::nth_element(durations, durations.begin() + series_nb / 2);
+  return durations[series_nb / 2];
+}
+
+// Ecrire un résultat au format CSV : nom,paramètre,ns par appel
+template<typename C>
+void report(std::basic_ostream<C>& out_stream, std::string_view name, auto parameter,
+            double nanoseconds) {
+  out_stream << name.data() << ',' << parameter << ',' << nanoseconds << std::endl;
+}
+
+enum class Format { csv, json };
+
+// Choisir le format de sortie d'après la ligne de commande : JSON Lines si l'un
+// des arguments est '--json', CSV sinon
+inline Format parse_format(int argc, char** argv) {
+  for (int i = 1; i < argc; i++)
+    if (std::string_view(argv[i]) == "--json") return Format::json;
+  return Format::csv;
+}
+
+// Ecrire un résultat au format demandé. En JSON, chaque ligne est un objet
+// {"name": ..., "parameter": ..., "ns": ...}
+template<typename C>
+void report(std::basic_ostream<C>& out_stream, Format format, std::string_view name,
+            auto parameter, double nanoseconds) {
+  if (format == Format::csv) {
+    report(out_stream, name, parameter, nanoseconds);
+    return;
+  }
+
+  out_stream << "{\"name\": \"" << name.data() << "\", \"parameter\": ";
+  if constexpr (std::is_arithmetic_v<decltype(parameter)>)
+    out_stream << parameter;
+  else
+    out_stream << '"' << parameter << '"';
+  out_stream << ", \"ns\": " << nanoseconds << '}' << std::endl;
+}
+
+} // namespace bench
@@ -73,6 +73,25 @@ void crossover_uniform(std::ranges::range auto&& genes1, std::ranges::range auto
   ltl::for_each(zipped_genes, ltl::unzip(lift(std::swap)));
 }
 
+/**
+  Croiser deux génomes bloc par bloc :
+  Les génomes sont donnés sous la forme de deux suites de blocs de gènes
+  contigus (par exemple les neurones d'un réseau, voir 'neural::Net::neurons').
+  Chaque bloc du premier génome a 1 chance sur 2 d'être permuté en entier avec
+  son homologue dans le second génome, ce qui préserve les gènes qui ont évolué
+  ensemble. Les blocs homologues doivent avoir la même taille.
+**/
+void crossover_blocks(std::ranges::range auto&& blocks1, std::ranges::range auto&& blocks2) {
+  std::mt19937                rnd_engine(generate_seed());
+  std::bernoulli_distribution should_swap_blocks(0.5);
+
+  auto block2 = std::ranges::begin(blocks2);
+  for (auto&& block1 : blocks1) {
+    if (should_swap_blocks(rnd_engine)) std::ranges::swap_ranges(block1, *block2);
+    ++block2;
+  }
+}
+
 /**
   Faire muter un génome :
   Chaque gene à une chance 'rate' d'être modifié par le foncteur 'rnd_modifier'.
@@ -3,6 +3,8 @@
 #include "../genetics.hpp"
 
 #include <list>
+#include <span>
+#include <vector>
 
 struct AssignementAwareInteger {
   AssignementAwareInteger(int content): copy_counter(0), move_counter(0), content(content) {}
@@ -78,6 +80,32 @@ TEST_CASE("genetics::crossover_uniform") {
 
 }
 
+TEST_CASE("genetics::crossover_blocks") {
+
+  std::vector<int> genes1(3 * 1000, 0);
+  std::vector<int> genes2(3 * 1000, 1);
+  std::vector<std::span<int>> blocks1, blocks2;
+  for (size_t i = 0; i < 1000; i++) {
+    blocks1.emplace_back(genes1.data() + 3 * i, 3);
+    blocks2.emplace_back(genes2.data() + 3 * i, 3);
+  }
+
+  SECTION("Les blocs sont permutés en entier avec leurs homologues respectifs, "
+          "et en moyenne la moitié des blocs sont permutés (si cette section du "
+          "test unitaire échoue, cela peut signifier que la distribution aléatoire "
+          "obtenue est atypique : dans ce cas, il faut réexecuter le test)") {
+
+    genetics::crossover_blocks(blocks1, blocks2);
+    for (size_t i = 0; i < 1000; i++) {
+      REQUIRE(ltl::count(blocks1[i], blocks1[i][0]) == 3);
+      REQUIRE(blocks1[i][0] + blocks2[i][0] == 1);
+    }
+    CHECK(abs(ltl::count(genes1, 1) - 1500) <= 300);
+
+  }
+
+}
+
 TEST_CASE("genetics::mutate") {
 
   std::list<bool> bool_l(1e4, false);
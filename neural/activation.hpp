@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/*******************************************************************************
+  Fonctions d'activation usuelles. 'ActivationSource' associe à une fonction
+  d'activation le code C++ équivalent (en fonction de la variable 'x'), ce qui
+  permet à 'generate_header' de la recopier dans le code généré.
+
+  'Tabulated' remplace le calcul d'une fonction d'activation bornée par une
+  interpolation linéaire entre des valeurs précalculées, ce qui évite un appel à
+  'std::exp' par neurone. Sur un pas h, l'erreur d'interpolation est majorée par
+  h² / 8 * max|f''| ; hors de l'intervalle tabulé, la fonction est saturée. Les
+  erreurs absolues maximales qui en découlent sont :
+    - 'tabulated_sigmoid' (1025 points sur [-16, 16]) : 2e-5
+    - 'tabulated_tanh'    (1025 points sur [-8, 8])   : 3e-5
+  Ces fonctions n'ont pas d'équivalent pour 'generate_header'.
+
+  'ActivationId' associe à une fonction d'activation un identifiant stable, qui
+  entre dans l'identifiant des couches sauvegardées (voir 'LayerId').
+*******************************************************************************/
+
+namespace neural {
+
+template<std::floating_point Scalar>
+Scalar relu(Scalar x) { return std::max(x, Scalar(0)); }
+
+template<std::floating_point Scalar>
+Scalar sigmoid(Scalar x) { return 1 / (1 + std::exp(-x)); }
+
+//
+template<std::floating_point Scalar, size_t Size>
+class Tabulated {
+public:
+  static_assert(Size >= 2, "A table needs at least two points");
+  static_assert(Size <= size_t(INT32_MAX), "The table index must fit in an int32_t");
+
+  Tabulated(std::invocable<Scalar> auto&& function, Scalar lower, Scalar upper)
+    : lower(lower),
+      upper(upper),
+      inverse_step((Size - 1) / (upper - lower))
+  {
+    for (size_t i = 0; i < Size; i++)
+      values[i] = function(lower + i * (upper - lower) / (Size - 1));
+  }
+
+  // La position dans la table est bornée avant sa conversion en entier, qui
+  // reste ainsi définie pour toute entrée : hors de l'intervalle tabulé la
+  // fonction est saturée, et NaN donne la valeur de la borne inférieure. La
+  // lecture dans la table n'est pas vectorisée par 'unaryExpr' : le gain vient
+  // de l'absence d'appel à 'std::exp'.
+  Scalar operator()(Scalar x) const {
+    Scalar position = (x - lower) * inverse_step;
+    position = position > 0 ? position : Scalar(0);
+    position = position < Scalar(Size - 1) ? position : Scalar(Size - 1);
+    int32_t index = std::min(static_cast<int32_t>(position), int32_t(Size - 2));
+    Scalar  fraction = position - index;
+    return values[index] + fraction * (values[index + 1] - values[index]);
+  }
+
+private:
+  Scalar                   lower;
+  Scalar                   upper;
+  Scalar                   inverse_step;
+  std::array<Scalar, Size> values;
+};
+
+template<std::floating_point Scalar>
+inline const Tabulated<Scalar, 1025> tabulated_sigmoid([](Scalar x) { return sigmoid(x); }, -16, 16);
+
+template<std::floating_point Scalar>
+inline const Tabulated<Scalar, 1025> tabulated_tanh([](Scalar x) { return std::tanh(x); }, -8, 8);
+
+template<auto& ActivationFunction>
+struct ActivationSource;
+
+template<>
+struct ActivationSource<relu<float>> { static constexpr std::string_view code = "x > 0.f ? x : 0.f"; };
+
+template<>
+struct ActivationSource<relu<double>> { static constexpr std::string_view code = "x > 0. ? x : 0."; };
+
+template<>
+struct ActivationSource<sigmoid<float>> { static constexpr std::string_view code = "1 / (1 + std::exp(-x))"; };
+
+template<>
+struct ActivationSource<sigmoid<double>> { static constexpr std::string_view code = "1 / (1 + std::exp(-x))"; };
+
+// Les identifiants inférieurs à 256 sont réservés aux fonctions de ce fichier :
+// une fonction définie ailleurs peut être sauvegardée en spécialisant
+// 'ActivationId' avec un identifiant plus grand (au plus 65535). La précision
+// n'en fait pas partie, la taille d'un scalaire étant vérifiée à part.
+template<auto& ActivationFunction>
+struct ActivationId;
+
+template<>
+struct ActivationId<relu<float>> { static constexpr uint32_t value = 1; };
+
+template<>
+struct ActivationId<relu<double>> { static constexpr uint32_t value = 1; };
+
+template<>
+struct ActivationId<sigmoid<float>> { static constexpr uint32_t value = 2; };
+
+template<>
+struct ActivationId<sigmoid<double>> { static constexpr uint32_t value = 2; };
+
+template<>
+struct ActivationId<tabulated_sigmoid<float>> { static constexpr uint32_t value = 3; };
+
+template<>
+struct ActivationId<tabulated_sigmoid<double>> { static constexpr uint32_t value = 3; };
+
+template<>
+struct ActivationId<tabulated_tanh<float>> { static constexpr uint32_t value = 4; };
+
+template<>
+struct ActivationId<tabulated_tanh<double>> { static constexpr uint32_t value = 4; };
+
+} // namespace neural
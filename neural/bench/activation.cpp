@@ -0,0 +1,64 @@
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+
+#include "../../benchmark.hpp"
+#include "../activation.hpp"
+#include "../linear.hpp"
+
+/*******************************************************************************
+  Comparer le coût de la sigmoïde et de la tangente hyperbolique calculées par
+  la bibliothèque standard, par une exponentielle polynomiale vectorisable et
+  par interpolation dans une table. Chaque fonction est appliquée à un vecteur
+  d'entrées ; les résultats sont écrits sur la sortie standard au format CSV,
+  le paramètre étant la taille du vecteur.
+*******************************************************************************/
+
+// Exponentielle par réduction d'argument (x = n ln2 + r) et polynôme de degré 5
+// en r, sans branchement ni appel de fonction pour que le compilateur puisse la
+// vectoriser. Erreur relative de l'ordre de 1e-6.
+float polynomial_exp(float x) {
+  x = std::clamp(x, -87.f, 88.f);
+  float n = std::nearbyint(x * 1.44269504f);
+  float r = x - n * 0.693147181f;
+  float p = 1 + r * (1 + r * (0.5f + r * (1.f / 6 + r * (1.f / 24 + r * (1.f / 120)))));
+  return p * std::bit_cast<float>(static_cast<int32_t>(n + 127) << 23);
+}
+
+float polynomial_sigmoid(float x) { return 1 / (1 + polynomial_exp(-x)); }
+float polynomial_tanh(float x) { return 2 * polynomial_sigmoid(2 * x) - 1; }
+
+int main() {
+  for (int size : {16, 256, 4096}) {
+    neural::Vector<float> input = 8 * neural::Vector<float>::Random(size);
+    neural::Vector<float> output(size);
+
+    bench::report(std::cout, "sigmoid/std::exp", size, bench::measure([&] {
+      output = input.unaryExpr(std::ref(neural::sigmoid<float>));
+      bench::keep(output);
+    }));
+    bench::report(std::cout, "sigmoid/polynomial", size, bench::measure([&] {
+      output = input.unaryExpr(std::ref(polynomial_sigmoid));
+      bench::keep(output);
+    }));
+    bench::report(std::cout, "sigmoid/tabulated", size, bench::measure([&] {
+      output = input.unaryExpr(std::ref(neural::tabulated_sigmoid<float>));
+      bench::keep(output);
+    }));
+    bench::report(std::cout, "tanh/std::tanh", size, bench::measure([&] {
+      output = input.unaryExpr([](float x) { return std::tanh(x); });
+      bench::keep(output);
+    }));
+    bench::report(std::cout, "tanh/polynomial", size, bench::measure([&] {
+      output = input.unaryExpr(std::ref(polynomial_tanh));
+      bench::keep(output);
+    }));
+    bench::report(std::cout, "tanh/tabulated", size, bench::measure([&] {
+      output = input.unaryExpr(std::ref(neural::tabulated_tanh<float>));
+      bench::keep(output);
+    }));
+  }
+
+  return 0;
+}
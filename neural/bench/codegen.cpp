@@ -0,0 +1,28 @@
+#include "generated_net.hpp"
+
+#include <iostream>
+
+#include "../../benchmark.hpp"
+#include "../ut/codegen_net.hpp"
+
+/*******************************************************************************
+  Comparer la latence d'une inférence par Eigen et par le code généré.
+  Les résultats sont écrits sur la sortie standard au format CSV.
+*******************************************************************************/
+
+int main() {
+  auto net = make_codegen_net();
+
+  neural::Vector<float> input = neural::Vector<float>::Random(generated_net::input_size);
+  float                 output[generated_net::output_size];
+
+  bench::report(std::cout, "Net::operator<<", 15, bench::measure([&] {
+    bench::keep(net << input);
+  }));
+  bench::report(std::cout, "generated_net::forward", 15, bench::measure([&] {
+    generated_net::forward(input.data(), output);
+    bench::keep(output);
+  }));
+
+  return 0;
+}
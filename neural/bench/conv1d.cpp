@@ -0,0 +1,42 @@
+#include <iostream>
+
+#include "../../benchmark.hpp"
+#include "../conv1d.hpp"
+#include "../static_perceptron.hpp"
+
+/*******************************************************************************
+  Comparer une convolution circulaire et un perceptron dense de même forme sur
+  un anneau de capteurs : 'width' entrées, 4 canaux de sortie. Les résultats
+  sont écrits sur la sortie standard au format CSV, le paramètre étant le nombre
+  de capteurs.
+*******************************************************************************/
+
+float relu(float x) { return std::max(x, 0.f); }
+
+template<int Width>
+void compare() {
+  neural::Conv1D<float, relu, 5, true>        convolution(Width, 4 * Width);
+  neural::StaticPerceptron<float, relu, true> perceptron(Width, 4 * Width);
+  for (auto& parameter : convolution.parameters.view()) parameter = 0.1f;
+  for (auto& parameter : perceptron.parameters.view()) parameter = 0.1f;
+
+  neural::Vector<float> input = neural::Vector<float>::Random(Width);
+  neural::Vector<float> output(4 * Width);
+
+  bench::report(std::cout, "Conv1D::propagate", Width, bench::measure([&] {
+    convolution.propagate(input, output);
+    bench::keep(output);
+  }));
+  bench::report(std::cout, "StaticPerceptron::propagate", Width, bench::measure([&] {
+    perceptron.propagate(input, output);
+    bench::keep(output);
+  }));
+}
+
+int main() {
+  compare<36>();
+  compare<90>();
+  compare<360>();
+
+  return 0;
+}
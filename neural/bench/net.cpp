@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+#include "../../benchmark.hpp"
+#include "../activation.hpp"
+#include "../net.hpp"
+#include "../perceptron.hpp"
+#include "../static_perceptron.hpp"
+
+/*******************************************************************************
+  Mesurer la latence de l'inférence en fonction de la taille des couches (de 4 à
+  1024), de la fonction d'activation et du type des poids :
+    - 'Net::operator<<' sur un vecteur et sur une matrice de 'batch_size'
+      colonnes, pour un réseau de deux couches carrées avec biais
+    - 'Perceptron::operator<<' sur un vecteur, pour comparer une fonction
+      d'activation connue à la compilation à un foncteur
+  Les résultats sont écrits sur la sortie standard en CSV, ou en JSON Lines avec
+  l'option '--json'. Le paramètre est la taille des couches.
+*******************************************************************************/
+
+constexpr int batch_size = 16;
+
+// Réduire le nombre d'itérations pour les grandes couches afin que chaque
+// mesure dure à peu près le même temps
+size_t iterations_nb(int size, int columns_nb = 1) {
+  return std::clamp<size_t>(1e8 / (double(size) * size * columns_nb), 10, 1e4);
+}
+
+template<typename Scalar, auto& ActivationFunction>
+void run(bench::Format format, std::string_view activation_name, int size) {
+  using Layer = neural::StaticPerceptron<Scalar, ActivationFunction, true>;
+  std::string name = std::string("Net<") + (sizeof(Scalar) == 4 ? "float" : "double")
+                   + ", " + activation_name.data() + ">::operator<<";
+
+  auto net = neural::Net<Layer, Layer> {size, size, size};
+  net.flatten();
+  for (auto& parameter : net.parameters()) parameter = Scalar(0.01);
+
+  neural::Vector<Scalar> input = neural::Vector<Scalar>::Random(size);
+  neural::Matrix<Scalar> inputs = neural::Matrix<Scalar>::Random(size, batch_size);
+
+  bench::report(std::cout, format, name + "(Vector)", size, bench::measure([&] {
+    bench::keep(net << input);
+  }, iterations_nb(size)));
+  bench::report(std::cout, format, name + "(Matrix)", size, bench::measure([&] {
+    bench::keep(net << inputs);
+  }, iterations_nb(size, batch_size)));
+}
+
+template<typename Scalar>
+void run_perceptron(bench::Format format, int size) {
+  auto relu = [](Scalar x) { return std::max(x, Scalar(0)); };
+  neural::Perceptron perceptron(neural::Matrix<Scalar>::Constant(size, size, Scalar(0.01)), relu);
+  std::string name = std::string("Perceptron<") + (sizeof(Scalar) == 4 ? "float" : "double")
+                   + ", relu>::operator<<(Vector)";
+
+  neural::Vector<Scalar> input = neural::Vector<Scalar>::Random(size);
+
+  bench::report(std::cout, format, name, size, bench::measure([&] {
+    bench::keep(perceptron << input);
+  }, iterations_nb(size)));
+}
+
+int main(int argc, char** argv) {
+  auto format = bench::parse_format(argc, argv);
+
+  for (int size : {4, 16, 64, 256, 1024}) {
+    run<float, neural::relu<float>>(format, "relu", size);
+    run<float, neural::sigmoid<float>>(format, "sigmoid", size);
+    run<float, neural::tabulated_sigmoid<float>>(format, "tabulated_sigmoid", size);
+    run<double, neural::relu<double>>(format, "relu", size);
+    run<double, neural::sigmoid<double>>(format, "sigmoid", size);
+    run<double, neural::tabulated_sigmoid<double>>(format, "tabulated_sigmoid", size);
+    run_perceptron<float>(format, size);
+    run_perceptron<double>(format, size);
+  }
+
+  return 0;
+}
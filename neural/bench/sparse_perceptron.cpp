@@ -0,0 +1,45 @@
+#include <iostream>
+#include <random>
+
+#include "../../benchmark.hpp"
+#include "../sparse_perceptron.hpp"
+#include "../static_perceptron.hpp"
+
+/*******************************************************************************
+  Chercher le point de bascule entre une couche dense et une couche creuse :
+  pour une couche 256 x 256, une proportion croissante des poids est mise à zéro
+  puis la latence de 'propagate' est mesurée pour les deux versions. Les
+  résultats sont écrits sur la sortie standard au format CSV, le paramètre étant
+  la proportion de poids nuls en pourcents.
+*******************************************************************************/
+
+float relu(float x) { return std::max(x, 0.f); }
+
+int main() {
+  constexpr int size = 256;
+
+  std::mt19937                          rnd_engine(1337);
+  std::uniform_real_distribution<float> make_noise(-1, 1);
+
+  neural::StaticPerceptron<float, relu> layer(size, size);
+  neural::Vector<float>                 input = neural::Vector<float>::Random(size);
+  neural::Vector<float>                 output(size);
+
+  for (int sparsity : {0, 25, 50, 75, 80, 85, 90, 95, 98, 99}) {
+    // Les poids sont uniformes sur [-1, 1] : ceux dont l'amplitude ne dépasse
+    // pas 'sparsity / 100' sont supprimés par 'prune'
+    for (auto& weight : layer.parameters.view()) weight = make_noise(rnd_engine);
+    auto sparse_layer = neural::prune(layer, sparsity / 100.f);
+
+    bench::report(std::cout, "StaticPerceptron::propagate", sparsity, bench::measure([&] {
+      layer.propagate(input, output);
+      bench::keep(output);
+    }));
+    bench::report(std::cout, "SparsePerceptron::propagate", sparsity, bench::measure([&] {
+      sparse_layer.propagate(input, output);
+      bench::keep(output);
+    }));
+  }
+
+  return 0;
+}
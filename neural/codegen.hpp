@@ -0,0 +1,118 @@
+#pragma once
+
+#include <ios>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "ltl/operator.h"
+
+#include "activation.hpp"
+#include "net.hpp"
+#include "static_perceptron.hpp"
+
+/*******************************************************************************
+  Génération de code : 'generate_header' écrit un en-tête C++ autonome (sans
+  Eigen) qui reproduit l'inférence d'un réseau entraîné. Les poids sont écrits
+  dans des tableaux 'constexpr' et la fonction 'forward' est entièrement
+  déroulée : chaque neurone est calculé par une seule expression, sans boucle
+  ni branchement. Les poids sont écrits en hexadécimal pour être reproduits
+  exactement.
+  Chaque fonction d'activation doit avoir une spécialisation de
+  'ActivationSource'.
+*******************************************************************************/
+
+namespace neural {
+
+//
+template<typename Scalar>
+void write_literal(std::ostream& out_stream, Scalar value) {
+  out_stream << std::hexfloat << value << std::defaultfloat;
+  if constexpr (std::is_same_v<Scalar, float>) out_stream << 'f';
+}
+
+// Ecrire le code d'une couche : ses poids, sa fonction d'activation et le calcul
+// de chacune de ses sorties
+template<typename Scalar, auto& ActivationFunction, bool Biased>
+void write_layer(std::ostream& out_stream, const StaticPerceptron<Scalar, ActivationFunction, Biased>& layer,
+                 int index, std::string_view input, std::string_view output) {
+  auto weights = layer.weights();
+
+  out_stream << "constexpr scalar weights" << index
+             << "[" << weights.rows() << "][" << weights.cols() << "] = {\n";
+  for (Eigen::Index i = 0; i < weights.rows(); i++) {
+    out_stream << "  {";
+    for (Eigen::Index j = 0; j < weights.cols(); j++) {
+      write_literal(out_stream, weights(i, j));
+      if (j + 1 < weights.cols()) out_stream << ", ";
+    }
+    out_stream << "},\n";
+  }
+  out_stream << "};\n\n";
+
+  if constexpr (Biased) {
+    auto bias = layer.bias();
+    out_stream << "constexpr scalar bias" << index << "[" << bias.size() << "] = {";
+    for (Eigen::Index i = 0; i < bias.size(); i++) {
+      write_literal(out_stream, bias[i]);
+      if (i + 1 < bias.size()) out_stream << ", ";
+    }
+    out_stream << "};\n\n";
+  }
+
+  out_stream << "inline scalar activation" << index << "(scalar x) { return "
+             << ActivationSource<ActivationFunction>::code << "; }\n\n";
+
+  out_stream << "inline void layer" << index << "(const scalar* " << input
+             << ", scalar* " << output << ") {\n";
+  for (Eigen::Index i = 0; i < weights.rows(); i++) {
+    out_stream << "  " << output << "[" << i << "] = activation" << index << "(";
+    if constexpr (Biased) out_stream << "bias" << index << "[" << i << "] + ";
+    for (Eigen::Index j = 0; j < weights.cols(); j++) {
+      if (j > 0) out_stream << " + ";
+      out_stream << "weights" << index << "[" << i << "][" << j << "] * "
+                 << input << "[" << j << "]";
+    }
+    if (weights.cols() == 0) out_stream << "0";
+    out_stream << ");\n";
+  }
+  out_stream << "}\n\n";
+}
+
+// Ecrire un en-tête définissant, dans l'espace de nom 'name', la fonction
+// 'forward(const scalar* input, scalar* output)' équivalente à 'net << input'
+template<typename Scalar, auto&... ActivationFunctions, bool... Biased>
+void generate_header(const Net<StaticPerceptron<Scalar, ActivationFunctions, Biased>...>& net,
+                     std::ostream& out_stream, std::string_view name) {
+  constexpr int layers_nb = sizeof...(ActivationFunctions);
+
+  out_stream << "#pragma once\n\n"
+             << "// Généré par neural::generate_header : ne pas modifier\n\n"
+             << "#include <cmath>\n\n"
+             << "namespace " << name << " {\n\n"
+             << "using scalar = " << (std::is_same_v<Scalar, float> ? "float" : "double") << ";\n\n"
+             << "constexpr int input_size = " << net[0_n].input_size() << ";\n"
+             << "constexpr int output_size = " << net[ltl::number_t<layers_nb - 1>()].output_size() << ";\n\n";
+
+  int index = 0;
+  net.for_each([&](const auto& layer) {
+    write_layer(out_stream, layer, index++, "input", "output");
+  });
+
+  out_stream << "inline void forward(const scalar* input, scalar* output) {\n";
+  index = 0;
+  net.for_each([&](const auto& layer) {
+    auto input = index == 0 ? std::string("input") : "buffer" + std::to_string(index - 1);
+    auto output = index == layers_nb - 1 ? std::string("output") : "buffer" + std::to_string(index);
+    if (index < layers_nb - 1)
+      out_stream << "  scalar " << output << "[" << layer.output_size() << "];\n";
+    out_stream << "  layer" << index << "(" << input << ", " << output << ");\n";
+    index++;
+  });
+  out_stream << "}\n\n"
+             << "} // namespace " << name << "\n";
+}
+
+} // namespace neural
@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+
+#include "linear.hpp"
+#include "parameters.hpp"
+
+/*******************************************************************************
+  Convolution à une dimension avec remplissage circulaire, adaptée à un anneau
+  de capteurs couvrant 360° : le premier et le dernier rayon sont voisins.
+
+  L'entrée est un unique canal de 'width' valeurs. Chacun des 'channels_nb'
+  canaux de sortie applique le même noyau de 'KernelSize' poids, centré, à
+  toutes les positions de l'entrée ; la sortie est la concaténation des canaux.
+  Une couche de 'width' entrées vers 'channels_nb * width' sorties ne possède
+  donc que 'channels_nb * KernelSize' poids (plus un biais par canal), ce qui
+  réduit d'autant le génome.
+
+  Le calcul est direct, sans recopie de l'entrée en matrice (im2col) : pour
+  chaque poids du noyau, l'entrée décalée est accumulée dans le canal de sortie
+  par une opération vectorielle. Seules les extrémités, où l'entrée est
+  repliée, sont traitées à part ; la boucle intérieure ne calcule aucun modulo.
+*******************************************************************************/
+
+namespace neural {
+
+template<typename Scalar, auto& ActivationFunction, int KernelSize, bool Biased = false>
+struct Conv1D {
+  static_assert(KernelSize % 2 == 1, "The kernel must have an odd size to be centered");
+
+  using scalar = Scalar;
+
+  static constexpr bool is_biased = Biased;
+  static constexpr int  kernel_size = KernelSize;
+
+  Conv1D(const Matrix<scalar>& weights, Eigen::Index width)
+    : Conv1D(width, weights.rows() * width)
+  {
+    this->weights() = weights;
+  }
+
+  Conv1D(const Matrix<scalar>& weights, const Vector<scalar>& bias, Eigen::Index width) requires Biased
+    : Conv1D(weights, width)
+  {
+    this->bias() = bias;
+  }
+
+  // La taille de sortie doit être un multiple de la taille d'entrée : le
+  // quotient est le nombre de canaux de sortie
+  Conv1D(Eigen::Index input_size, Eigen::Index output_size)
+    : parameters(parameters_nb(input_size, output_size)),
+      width(input_size),
+      channels_nb(input_size > 0 ? output_size / input_size : 0)
+  {}
+
+  // Accéder aux noyaux : une ligne par canal de sortie
+  Eigen::Map<Matrix<scalar>> weights() {
+    return {parameters.data(), channels_nb, KernelSize};
+  }
+  Eigen::Map<const Matrix<scalar>> weights() const {
+    return {parameters.data(), channels_nb, KernelSize};
+  }
+
+  // Accéder aux biais : un par canal de sortie
+  Eigen::Map<Vector<scalar>> bias() requires Biased {
+    return {parameters.data() + channels_nb * KernelSize, channels_nb};
+  }
+  Eigen::Map<const Vector<scalar>> bias() const requires Biased {
+    return {parameters.data() + channels_nb * KernelSize, channels_nb};
+  }
+
+  //
+  Vector<scalar> operator<<(const Vector<scalar>& input) const {
+    Vector<scalar> output(output_size());
+    propagate(input, output);
+    return output;
+  }
+
+  // Chaque colonne de 'input' est traitée indépendamment
+  Matrix<scalar> operator<<(const Matrix<scalar>& input) const {
+    Matrix<scalar> output(output_size(), input.cols());
+    Vector<scalar> column(input_size()), result(output_size());
+    for (Eigen::Index j = 0; j < input.cols(); j++) {
+      column = input.col(j);
+      propagate(column, result);
+      output.col(j) = result;
+    }
+    return output;
+  }
+
+  // Calculer l'image de 'input' dans 'output' sans allocation lorsque 'output' a
+  // déjà la bonne taille (sauf si la fonction d'activation est de type
+  // Returning)
+  void propagate(const Vector<scalar>& input, Vector<scalar>& output) const {
+    using F = decltype(ActivationFunction);
+    static_assert(Vectorizable<F, scalar> || Modifying<F, Vector<scalar>>
+                  || Returning<F, Vector<scalar>>,
+                  "Activation function must satisfy one of the following : "
+                  "Vectorizable<scalar>, Modifying<Vector<scalar>> or "
+                  "Returning<Vector<scalar>>");
+    output.resize(output_size());
+    for (Eigen::Index channel = 0; channel < channels_nb; channel++)
+      convolve(input, channel, output.segment(channel * width, width));
+
+    if constexpr (Vectorizable<F, scalar>) {
+      output = output.unaryExpr(std::ref(ActivationFunction));
+    } else if constexpr (Modifying<F, Vector<scalar>>) {
+      ActivationFunction(output);
+    } else {
+      output = ActivationFunction(output);
+    }
+  }
+
+  //
+  auto input_size() const {
+    return width;
+  }
+
+  //
+  auto output_size() const {
+    return channels_nb * width;
+  }
+
+  // Coût d'une inférence sur un vecteur, hors fonction d'activation
+  size_t flops() const {
+    return (2 * KernelSize + (Biased ? 1 : 0)) * channels_nb * width;
+  }
+  size_t parameter_bytes() const {
+    return parameters.size() * sizeof(scalar);
+  }
+  size_t activation_bytes() const {
+    return channels_nb * width * sizeof(scalar);
+  }
+
+  //
+  void resize(Eigen::Index input_size, Eigen::Index output_size) {
+    parameters.resize(parameters_nb(input_size, output_size));
+    width = input_size;
+    channels_nb = input_size > 0 ? output_size / input_size : 0;
+  }
+
+  // Changer la forme de la couche en utilisant 'data', déjà rangé pour cette
+  // forme, comme stockage externe des paramètres (voir 'map_net')
+  void map(scalar* data, Eigen::Index input_size, Eigen::Index output_size) {
+    parameters.map(data, parameters_nb(input_size, output_size));
+    width = input_size;
+    channels_nb = input_size > 0 ? output_size / input_size : 0;
+  }
+
+  // Nombre de paramètres d'une couche de cette forme
+  static Eigen::Index parameters_nb(Eigen::Index input_size, Eigen::Index output_size) {
+    if (input_size > 0 && output_size % input_size != 0)
+      throw std::invalid_argument("Conv1D output size must be a multiple of its input size");
+    auto channels_nb = input_size > 0 ? output_size / input_size : 0;
+    return channels_nb * KernelSize + (Biased ? channels_nb : 0);
+  }
+
+  Parameters<scalar> parameters;
+
+private:
+  // Calculer un canal de sortie, sans fonction d'activation. Pour un décalage
+  // 'shift', la sortie en i reçoit l'entrée en (i + shift) modulo 'width'. Le
+  // décalage est d'abord ramené dans [0, width), ce qui reste juste lorsque
+  // l'entrée est plus étroite que le noyau : la partie intérieure est alors un
+  // unique produit vectoriel, et la partie repliée ('shift' valeurs) est
+  // traitée séparément.
+  void convolve(const Vector<scalar>& input, Eigen::Index channel, auto&& output) const {
+    if constexpr (Biased) output.setConstant(bias()[channel]);
+    else output.setZero();
+    if (width == 0) return;
+
+    for (Eigen::Index k = 0; k < KernelSize; k++) {
+      auto weight = weights()(channel, k);
+      auto shift = ((k - KernelSize / 2) % width + width) % width;
+      auto inner_nb = width - shift;
+
+      output.head(inner_nb) += weight * input.segment(shift, inner_nb);
+      output.tail(shift) += weight * input.head(shift);
+    }
+  }
+
+  Eigen::Index width;
+  Eigen::Index channels_nb;
+};
+
+//
+template<typename Scalar, auto& ActivationFunction, int KernelSize, bool Biased>
+struct LayerId<Conv1D<Scalar, ActivationFunction, KernelSize, Biased>> {
+  static_assert(KernelSize < 128, "The kernel size must fit in the layer id");
+  static constexpr uint32_t value = make_layer_id(2, KernelSize << 1 | Biased, ActivationId<ActivationFunction>::value);
+};
+
+} // namespace neural
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+
+#include <unistd.h>
+
+#include "net.hpp"
+
+/*******************************************************************************
+  Outils pour dimensionner l'entraînement à partir du coût estimé d'un réseau
+  (voir 'Net::flops', 'Net::parameter_bytes' et 'Net::activation_bytes') : un
+  réseau dont les paramètres et les sorties intermédiaires tiennent dans le
+  cache L1 ou L2 peut être évalué à chaque pas sans attendre la mémoire.
+
+  Les tailles de cache sont lues par 'sysconf' lorsque le système les fournit ;
+  sinon, des valeurs courantes sont utilisées (32 Kio pour L1, 256 Kio pour L2).
+*******************************************************************************/
+
+namespace neural {
+
+inline constexpr size_t default_l1_cache_bytes = 32 * 1024;
+inline constexpr size_t default_l2_cache_bytes = 256 * 1024;
+
+// Taille du cache de données L1 d'un coeur
+inline size_t l1_cache_bytes() {
+#ifdef _SC_LEVEL1_DCACHE_SIZE
+  if (auto size = sysconf(_SC_LEVEL1_DCACHE_SIZE); size > 0) return size;
+#endif
+  return default_l1_cache_bytes;
+}
+
+// Taille du cache L2 d'un coeur
+inline size_t l2_cache_bytes() {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+  if (auto size = sysconf(_SC_LEVEL2_CACHE_SIZE); size > 0) return size;
+#endif
+  return default_l2_cache_bytes;
+}
+
+// Mémoire parcourue par une inférence : les paramètres et la sortie de chaque
+// couche
+template<typename... Layers>
+constexpr size_t working_set_bytes(const Net<Layers...>& net) {
+  return net.parameter_bytes() + net.activation_bytes();
+}
+
+template<typename NetType> requires NetType::is_statically_costed
+constexpr size_t working_set_bytes() {
+  return NetType::parameter_bytes() + NetType::activation_bytes();
+}
+
+// Vérifier qu'une inférence tient dans 'cache_bytes' octets
+template<typename... Layers>
+bool fits_in_cache(const Net<Layers...>& net, size_t cache_bytes = l1_cache_bytes()) {
+  return working_set_bytes(net) <= cache_bytes;
+}
+
+} // namespace neural
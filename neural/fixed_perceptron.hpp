@@ -0,0 +1,150 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+
+#include "linear.hpp"
+#include "parameters.hpp"
+
+/*******************************************************************************
+  Perceptron dont la forme est connue à la compilation : les produits
+  matrice-vecteur portent sur des matrices de taille fixe, et le coût d'une
+  inférence ('flops', 'parameter_bytes', 'activation_bytes') est 'constexpr'.
+  Comme 'StaticPerceptron', les poids et le biais éventuel sont stockés dans
+  'parameters' et font partie du génome lorsque le réseau est aplati.
+*******************************************************************************/
+
+namespace neural {
+
+template<typename Scalar, auto& ActivationFunction, int InputSize, int OutputSize,
+         bool Biased = false>
+struct FixedPerceptron {
+  using scalar = Scalar;
+  using FixedMatrix = Eigen::Matrix<Scalar, OutputSize, InputSize>;
+  using FixedVector = Eigen::Matrix<Scalar, OutputSize, 1>;
+
+  static constexpr bool is_biased = Biased;
+
+  FixedPerceptron()
+    : parameters(parameters_nb)
+  {}
+
+  FixedPerceptron(const FixedMatrix& weights)
+    : FixedPerceptron()
+  {
+    this->weights() = weights;
+  }
+
+  FixedPerceptron(const FixedMatrix& weights, const FixedVector& bias) requires Biased
+    : FixedPerceptron(weights)
+  {
+    this->bias() = bias;
+  }
+
+  // Permet de construire la couche comme les autres, par exemple depuis 'Net' :
+  // la forme demandée doit être celle du type
+  FixedPerceptron(Eigen::Index input_size, Eigen::Index output_size)
+    : FixedPerceptron()
+  {
+    if (input_size != InputSize || output_size != OutputSize)
+      throw std::invalid_argument("FixedPerceptron cannot change its shape");
+  }
+
+  // Accéder à la matrice de poids, stockée dans 'parameters'
+  Eigen::Map<FixedMatrix> weights() {
+    return Eigen::Map<FixedMatrix>(parameters.data());
+  }
+  Eigen::Map<const FixedMatrix> weights() const {
+    return Eigen::Map<const FixedMatrix>(parameters.data());
+  }
+
+  // Accéder au vecteur de biais, stocké dans 'parameters' à la suite des poids
+  Eigen::Map<FixedVector> bias() requires Biased {
+    return Eigen::Map<FixedVector>(parameters.data() + OutputSize * InputSize);
+  }
+  Eigen::Map<const FixedVector> bias() const requires Biased {
+    return Eigen::Map<const FixedVector>(parameters.data() + OutputSize * InputSize);
+  }
+
+  //
+  Vector<scalar> operator<<(const Vector<scalar>& input) const {
+    Vector<scalar> output(OutputSize);
+    propagate(input, output);
+    return output;
+  }
+
+  //
+  Matrix<scalar> operator<<(const Matrix<scalar>& input) const {
+    using F = decltype(ActivationFunction);
+    static_assert(Vectorizable<F, scalar> || Modifying<F, Matrix<scalar>>
+               || Returning<F, Matrix<scalar>>,
+                  "Activation function must satisfy one of the following : "
+                  "Vectorizable<scalar>, Modifying<Matrix<scalar>> or "
+                  "Returning<Matrix<scalar>>");
+    Matrix<scalar> output(weights() * input);
+    if constexpr (Biased) output.colwise() += bias();
+    if constexpr (Vectorizable<F, scalar>) {
+      return output.unaryExpr(std::ref(ActivationFunction));
+    } else if constexpr (Modifying<F, Matrix<scalar>>) {
+      ActivationFunction(output);
+      return output;
+    } else {
+      return ActivationFunction(output);
+    }
+  }
+
+  // Calculer l'image de 'input' dans 'output' sans allocation lorsque 'output' a
+  // déjà la bonne taille (sauf si la fonction d'activation est de type
+  // Returning)
+  void propagate(const Vector<scalar>& input, Vector<scalar>& output) const {
+    using F = decltype(ActivationFunction);
+    static_assert(Vectorizable<F, scalar> || Modifying<F, Vector<scalar>>
+                  || Returning<F, Vector<scalar>>,
+                  "Activation function must satisfy one of the following : "
+                  "Vectorizable<scalar>, Modifying<Vector<scalar>> or "
+                  "Returning<Vector<scalar>>");
+    output.noalias() = weights() * input;
+    if constexpr (Vectorizable<F, scalar>) {
+      if constexpr (Biased)
+        output = (output + bias()).unaryExpr(std::ref(ActivationFunction));
+      else
+        output = output.unaryExpr(std::ref(ActivationFunction));
+    } else {
+      if constexpr (Biased) output += bias();
+      if constexpr (Modifying<F, Vector<scalar>>)
+        ActivationFunction(output);
+      else
+        output = ActivationFunction(output);
+    }
+  }
+
+  //
+  static constexpr Eigen::Index input_size() {
+    return InputSize;
+  }
+
+  //
+  static constexpr Eigen::Index output_size() {
+    return OutputSize;
+  }
+
+  // Coût d'une inférence sur un vecteur, hors fonction d'activation
+  static constexpr size_t flops() {
+    return 2 * InputSize * OutputSize + (Biased ? OutputSize : 0);
+  }
+  static constexpr size_t parameter_bytes() {
+    return parameters_nb * sizeof(Scalar);
+  }
+  static constexpr size_t activation_bytes() {
+    return OutputSize * sizeof(Scalar);
+  }
+
+  Parameters<scalar> parameters;
+
+private:
+  static constexpr Eigen::Index parameters_nb = OutputSize * InputSize + (Biased ? OutputSize : 0);
+};
+
+} // namespace neural
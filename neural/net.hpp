@@ -1,15 +1,25 @@
 #pragma once
 
+#include <algorithm>
 #include <concepts>
+#include <cstddef>
+#include <cstring>
 #include <iterator>
 #include <ranges>
+#include <span>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "ltl/operator.h"
 #include "ltl/Tuple.h"
 
+#include "linear.hpp"
+#include "parameters.hpp"
+
 /*******************************************************************************
 *******************************************************************************/
 
@@ -36,11 +46,108 @@ concept Layer = requires(T t, int8_t n) {
 template<typename T>
 concept Resizable = requires(T t, int8_t n) { t.resize(n, n); };
 
+// Une couche dont les paramètres peuvent être déplacés dans un tampon externe
+template<typename T>
+concept Mappable = Layer<T> && requires(T t) {
+  { t.parameters } -> std::same_as<Parameters<typename T::scalar>&>;
+};
+
+// Type du tampon unique d'un réseau aplati : il n'existe que si toutes les
+// couches sont 'Mappable' et partagent le même type de scalaire
+template<typename... Layers>
+struct flat_buffer { using type = std::monostate; };
+
+template<Mappable First, Mappable... Others>
+  requires (std::same_as<typename First::scalar, typename Others::scalar> && ...)
+struct flat_buffer<First, Others...> { using type = ParameterBuffer<typename First::scalar>; };
+
+// Mémoire de travail d'une couche : sa sortie, ou bien le type 'Workspace'
+// qu'elle définit lorsqu'elle doit conserver un état d'un appel à l'autre (par
+// exemple l'état caché d'une couche récurrente). Un tel type se construit à
+// partir de la taille de sortie, expose la sortie dans 'output' et l'état est
+// remis à zéro par 'reset'.
+template<typename T>
+struct layer_workspace { using type = Vector<typename T::scalar>; };
+
+template<typename T> requires requires { typename T::Workspace; }
+struct layer_workspace<T> { using type = typename T::Workspace; };
+
+template<typename T>
+using layer_workspace_t = typename layer_workspace<T>::type;
+
+//
+template<typename Scalar>
+const Vector<Scalar>& output_of(const Vector<Scalar>& workspace) { return workspace; }
+const auto& output_of(const auto& workspace) { return workspace.output; }
+
+//
+template<typename Scalar>
+void reset_state(Vector<Scalar>&) {}
+void reset_state(auto& workspace) { workspace.reset(); }
+
+// Une couche dont les paramètres sont rangés neurone par neurone : les
+// 'neuron_size()' paramètres de chaque neurone de sortie se suivent
+template<typename T>
+concept NeuronBlocked = Mappable<T> && requires(const T t) {
+  { t.neuron_size() } -> std::integral;
+};
+
+// Une couche rangée neurone par neurone dont la forme peut être changée sans
+// toucher à ses paramètres, ceux-ci étant réarrangés par le réseau
+template<typename T>
+concept Reshapeable = NeuronBlocked<T> && requires(T t, typename T::scalar* data, Eigen::Index n) {
+  t.map(data, n, n);
+};
+
+// Une couche capable d'écrire sa sortie dans une mémoire de travail fournie par
+// l'appelant
+template<typename T>
+concept Propagatable = Layer<T> && requires(const T t, const Vector<typename T::scalar> input,
+                                            layer_workspace_t<T> workspace) {
+  t.propagate(input, workspace);
+};
+
+// Une couche capable d'estimer le coût d'une inférence sur un vecteur : nombre
+// d'opérations flottantes, taille de ses paramètres et de sa sortie en octets
+template<typename T>
+concept Costed = Layer<T> && requires(const T t) {
+  { t.flops() } -> std::convertible_to<size_t>;
+  { t.parameter_bytes() } -> std::convertible_to<size_t>;
+  { t.activation_bytes() } -> std::convertible_to<size_t>;
+};
+
+// Une couche dont la forme, et donc le coût, est connue à la compilation
+template<typename T>
+concept StaticallyCosted = Costed<T> && requires {
+  typename std::integral_constant<size_t, T::flops()>;
+  typename std::integral_constant<size_t, T::parameter_bytes()>;
+  typename std::integral_constant<size_t, T::activation_bytes()>;
+};
+
+// Type de la mémoire de travail de 'Net::propagate' : celle de chaque couche
+template<typename... Layers>
+struct workspace { using type = std::monostate; };
+
+template<Propagatable First, Propagatable... Others>
+struct workspace<First, Others...> {
+  using type = std::tuple<layer_workspace_t<First>, layer_workspace_t<Others>...>;
+};
+
 template<Layer... Layers>
 class Net {
   template<typename... Args> friend auto make_net(Args&&...);
 
+  using buffer_type = typename flat_buffer<Layers...>::type;
+
 public:
+  using Workspace = typename workspace<Layers...>::type;
+
+  static constexpr bool is_flattenable = !std::same_as<buffer_type, std::monostate>;
+  static constexpr bool is_propagatable = !std::same_as<Workspace, std::monostate>;
+  static constexpr bool is_neuron_blocked = (NeuronBlocked<Layers> && ...);
+  static constexpr bool is_costed = (Costed<Layers> && ...);
+  static constexpr bool is_statically_costed = (StaticallyCosted<Layers> && ...);
+
   // Construire le réseau en donnant les tailles des intercouches
   template<std::integral... Ints> requires (sizeof...(Ints) - 1 == sizeof...(Layers))
   Net(Ints... layer_sizes)
@@ -48,6 +155,19 @@ public:
   Net(const std::ranges::range auto& layer_sizes)
     : Net(std::vector(layer_sizes.begin(), layer_sizes.end()), layer_tuple.make_indexer()) {}
 
+  // Copier un réseau : si le réseau est aplati, son tampon est copié d'un seul
+  // bloc et les couches de la copie sont reliées au nouveau tampon
+  Net(const Net& other)
+    : layer_tuple(other.layer_tuple),
+      buffer(other.buffer)
+  {
+    map_layers();
+  }
+  Net(Net&&) = default;
+
+  Net& operator=(const Net& other) { return *this = Net(other); }
+  Net& operator=(Net&&) = default;
+
   // Accéder à une couche
   auto&       operator[](auto i) { return layer_tuple[i]; };
   const auto& operator[](auto i) const { return layer_tuple[i]; }
@@ -57,6 +177,63 @@ public:
   decltype(auto) operator<<(T&& input) {
     return propagate_forward(std::forward<T>(input), layer_tuple.make_indexer());
   }
+  template<typename T>
+  decltype(auto) operator<<(T&& input) const {
+    return propagate_forward(std::forward<T>(input), layer_tuple.make_indexer());
+  }
+
+  // Préparer une mémoire de travail pour 'propagate'
+  Workspace make_workspace() const requires is_propagatable {
+    return make_workspace(layer_tuple.make_indexer());
+  }
+
+  // Calculer le résultat d'une entrée par le réseau en stockant la sortie de
+  // chaque couche dans 'workspace'. Le réseau n'est pas modifié et aucune
+  // allocation n'est faite : plusieurs threads peuvent utiliser le même réseau
+  // en même temps, chacun avec sa propre mémoire de travail.
+  const auto& propagate(const auto& input, Workspace& workspace) const requires is_propagatable {
+    propagate(input, workspace, layer_tuple.make_indexer());
+    return output_of(std::get<sizeof...(Layers) - 1>(workspace));
+  }
+
+  // Remettre à zéro l'état conservé dans une mémoire de travail, par exemple au
+  // début d'une épreuve. Aucune allocation n'est faite.
+  static void reset(Workspace& workspace) requires is_propagatable {
+    std::apply([](auto&... layer_workspaces) { (reset_state(layer_workspaces), ...); }, workspace);
+  }
+
+  // Estimer le coût d'une inférence sur un vecteur : nombre d'opérations
+  // flottantes (hors fonctions d'activation), taille des paramètres et taille
+  // des sorties de toutes les couches, en octets. Lorsque la forme de toutes les
+  // couches est connue à la compilation, ces fonctions sont 'constexpr' et
+  // statiques, ce qui permet par exemple de vérifier par 'static_assert' qu'un
+  // réseau tient dans le cache L1.
+  static constexpr size_t flops() requires is_statically_costed {
+    return (Layers::flops() + ...);
+  }
+  size_t flops() const requires (is_costed && !is_statically_costed) {
+    size_t sum = 0;
+    for_each([&](const auto& layer) { sum += layer.flops(); });
+    return sum;
+  }
+
+  static constexpr size_t parameter_bytes() requires is_statically_costed {
+    return (Layers::parameter_bytes() + ...);
+  }
+  size_t parameter_bytes() const requires (is_costed && !is_statically_costed) {
+    size_t sum = 0;
+    for_each([&](const auto& layer) { sum += layer.parameter_bytes(); });
+    return sum;
+  }
+
+  static constexpr size_t activation_bytes() requires is_statically_costed {
+    return (Layers::activation_bytes() + ...);
+  }
+  size_t activation_bytes() const requires (is_costed && !is_statically_costed) {
+    size_t sum = 0;
+    for_each([&](const auto& layer) { sum += layer.activation_bytes(); });
+    return sum;
+  }
 
   // Redimensionner une intercouche
   template<int I>
@@ -67,6 +244,7 @@ public:
     }
     if constexpr (I < sizeof...(Layers))
       resize(index, new_size, layer_tuple[index].output_size());
+    keep_flat();
   }
 
   // Redimensionner une série d'intercouches consécutives
@@ -74,14 +252,107 @@ public:
   void resize(ltl::number_t<B> begin, ltl::number_t<E> end,
               const std::ranges::range auto& new_sizes) {
     resize(begin, end, {new_sizes.begin(), new_sizes.end()}, int_range<B, E - 1>());
+    keep_flat();
   }
   template<int B, int E>
   void resize(ltl::number_t<B> begin, ltl::number_t<E> end, const std::vector<size_t>& new_sizes) {
     resize(begin, end, new_sizes, int_range<B, E - 1>());
+    keep_flat();
   }
   template<int B, int E>
   void resize(ltl::number_t<B> begin, ltl::number_t<E> end, std::vector<size_t>&& new_sizes) {
     resize(begin, end, std::move(new_sizes), int_range<B, E - 1>());
+    keep_flat();
+  }
+
+  // Réserver dans le tampon d'un réseau aplati la place de 'parameters_nb'
+  // paramètres : tant que cette taille n'est pas dépassée, 'grow' ne réalloue
+  // pas le tampon. Le réseau est aplati s'il ne l'était pas.
+  void reserve(size_t parameters_nb) requires is_flattenable {
+    if (buffer.empty()) flatten();
+    auto data = buffer.data();
+    buffer.reserve(parameters_nb);
+    if (buffer.data() != data) map_layers();
+  }
+
+  // Ajouter 'count' neurones à l'intercouche 'index' en conservant tous les
+  // paramètres existants. Les nouveaux neurones de la couche précédente et les
+  // poids qui les relient à la couche suivante sont nuls : la sortie du réseau
+  // est inchangée. Les paramètres sont déplacés sur place dans le tampon, qui
+  // n'est réalloué que si sa capacité (voir 'reserve') est insuffisante.
+  template<int I> requires (0 < I && I < sizeof...(Layers))
+                        && Reshapeable<std::tuple_element_t<I - 1, std::tuple<Layers...>>>
+                        && Reshapeable<std::tuple_element_t<I, std::tuple<Layers...>>>
+  void grow(ltl::number_t<I> index, Eigen::Index count) requires is_flattenable {
+    auto& previous = layer_tuple[ltl::number_t<I - 1>()];
+    auto& next = layer_tuple[index];
+    auto  added_nb = count * (previous.neuron_size() + next.output_size());
+
+    if (buffer.empty()) flatten();
+    auto old_size = buffer.size();
+    if (buffer.capacity() < old_size + added_nb) reserve(old_size + added_nb);
+    buffer.resize(old_size + added_nb);
+
+    // Les paramètres sont déplacés vers la droite : les couches suivantes d'un
+    // bloc, puis les neurones de la couche suivante du dernier au premier
+    auto next_data = next.parameters.data();
+    auto tail = next_data + next.parameters.size();
+    std::memmove(tail + added_nb, tail, (buffer.data() + old_size - tail) * sizeof(*tail));
+
+    auto inputs_nb = next.input_size();
+    auto old_neuron_size = next.neuron_size();
+    auto new_next_data = next_data + count * previous.neuron_size();
+    for (auto i = next.output_size() - 1; i >= 0; i--) {
+      auto old_neuron = next_data + i * old_neuron_size;
+      auto new_neuron = new_next_data + i * (old_neuron_size + count);
+      std::memmove(new_neuron + inputs_nb + count, old_neuron + inputs_nb,
+                   (old_neuron_size - inputs_nb) * sizeof(*old_neuron));
+      std::memmove(new_neuron, old_neuron, inputs_nb * sizeof(*old_neuron));
+      std::fill_n(new_neuron + inputs_nb, count, 0);
+    }
+    std::fill_n(next_data, count * previous.neuron_size(), 0);
+
+    previous.map(previous.parameters.data(), previous.input_size(), previous.output_size() + count);
+    next.map(new_next_data, inputs_nb + count, next.output_size());
+    map_layers();
+  }
+
+  // Retirer les 'count' derniers neurones de l'intercouche 'index', ainsi que
+  // les poids qui les relient à la couche suivante. Les autres paramètres sont
+  // conservés et le tampon n'est pas réalloué.
+  template<int I> requires (0 < I && I < sizeof...(Layers))
+                        && Reshapeable<std::tuple_element_t<I - 1, std::tuple<Layers...>>>
+                        && Reshapeable<std::tuple_element_t<I, std::tuple<Layers...>>>
+  void shrink(ltl::number_t<I> index, Eigen::Index count) requires is_flattenable {
+    auto& previous = layer_tuple[ltl::number_t<I - 1>()];
+    auto& next = layer_tuple[index];
+    if (count > previous.output_size())
+      throw std::invalid_argument("Cannot remove more neurons than the layer has");
+    auto removed_nb = count * (previous.neuron_size() + next.output_size());
+
+    if (buffer.empty()) flatten();
+    auto old_size = buffer.size();
+
+    // Les paramètres sont déplacés vers la gauche : les neurones de la couche
+    // suivante du premier au dernier, puis les couches suivantes d'un bloc
+    auto next_data = next.parameters.data();
+    auto tail = next_data + next.parameters.size();
+    auto inputs_nb = next.input_size();
+    auto old_neuron_size = next.neuron_size();
+    auto new_next_data = next_data - count * previous.neuron_size();
+    for (Eigen::Index i = 0; i < next.output_size(); i++) {
+      auto old_neuron = next_data + i * old_neuron_size;
+      auto new_neuron = new_next_data + i * (old_neuron_size - count);
+      std::memmove(new_neuron, old_neuron, (inputs_nb - count) * sizeof(*old_neuron));
+      std::memmove(new_neuron + inputs_nb - count, old_neuron + inputs_nb,
+                   (old_neuron_size - inputs_nb) * sizeof(*old_neuron));
+    }
+    std::memmove(tail - removed_nb, tail, (buffer.data() + old_size - tail) * sizeof(*tail));
+    buffer.resize(old_size - removed_nb);
+
+    previous.map(previous.parameters.data(), previous.input_size(), previous.output_size() - count);
+    next.map(new_next_data, inputs_nb - count, next.output_size());
+    map_layers();
   }
 
   // Appliquer un foncteur à chaque couche du réseau
@@ -89,6 +360,49 @@ public:
   void for_each(F&& ftor) {
     ltl::for_each(layer_tuple, ftor);
   }
+  template<typename F>
+  void for_each(F&& ftor) const {
+    ltl::for_each(layer_tuple, ftor);
+  }
+
+  // Regrouper les paramètres de toutes les couches dans un unique tampon
+  // contigu et aligné, que les couches utilisent ensuite pour stocker leurs
+  // paramètres. Le réseau reste aplati lorsqu'il est copié ou redimensionné.
+  void flatten() requires is_flattenable {
+    Eigen::Index size = 0;
+    for_each([&](const auto& layer) { size += layer.parameters.size(); });
+
+    buffer_type new_buffer(size);
+    auto data = new_buffer.data();
+    for_each([&](auto& layer) {
+      std::ranges::copy(layer.parameters.view(), data);
+      layer.parameters.map(data);
+      data += layer.parameters.size();
+    });
+    buffer = std::move(new_buffer);
+  }
+
+  // Accéder aux paramètres d'un réseau aplati, dans l'ordre des couches
+  auto parameters() requires is_flattenable {
+    return std::span(buffer);
+  }
+  auto parameters() const requires is_flattenable {
+    return std::span(std::as_const(buffer));
+  }
+
+  // Découper les paramètres d'un réseau aplati en neurones : un bloc contigu par
+  // neurone de sortie de chaque couche, dans l'ordre des couches. Croiser deux
+  // réseaux bloc par bloc (voir 'genetics::crossover_blocks') conserve les
+  // neurones entiers.
+  auto neurons() requires is_flattenable && is_neuron_blocked {
+    std::vector<std::span<typename buffer_type::value_type>> blocks;
+    for_each([&](auto& layer) {
+      auto data = layer.parameters.data();
+      for (Eigen::Index i = 0; i < layer.output_size(); i++, data += layer.neuron_size())
+        blocks.emplace_back(data, layer.neuron_size());
+    });
+    return blocks;
+  }
 
 private:
   // Construire un réseau en passant les couches via perfect forwarding
@@ -114,6 +428,31 @@ private:
   decltype(auto) propagate_forward(T&& input, ltl::number_list_t<Is...>) {
     return (layer_tuple[ltl::number_t<sizeof...(Layers) - 1 - Is>()] << ... << std::forward<T>(input));
   }
+  template<typename T, int... Is>
+  decltype(auto) propagate_forward(T&& input, ltl::number_list_t<Is...>) const {
+    return (layer_tuple[ltl::number_t<sizeof...(Layers) - 1 - Is>()] << ... << std::forward<T>(input));
+  }
+
+  //
+  template<int... Is>
+  Workspace make_workspace(ltl::number_list_t<Is...>) const {
+    return {typename std::tuple_element_t<Is, Workspace>(layer_tuple[ltl::number_t<Is>()].output_size())...};
+  }
+
+  // Invoquer successivement chaque couche, la sortie d'une couche étant l'entrée
+  // de la suivante
+  template<int... Is>
+  void propagate(const auto& input, Workspace& workspace, ltl::number_list_t<Is...>) const {
+    (propagate(ltl::number_t<Is>(), input, workspace), ...);
+  }
+
+  template<int I>
+  void propagate(ltl::number_t<I> index, const auto& input, Workspace& workspace) const {
+    if constexpr (I == 0)
+      layer_tuple[index].propagate(input, std::get<0>(workspace));
+    else
+      layer_tuple[index].propagate(output_of(std::get<I - 1>(workspace)), std::get<I>(workspace));
+  }
 
   // Redimensionner
   template<int B, int E, int... Is>
@@ -146,7 +485,26 @@ private:
       layer_tuple[layer_index] = L(new_input_size, new_output_size);
   }
 
+  // Relier les couches au tampon du réseau, si celui-ci est aplati
+  void map_layers() {
+    if constexpr (is_flattenable) {
+      auto data = buffer.data();
+      if (buffer.empty()) return;
+      for_each([&](auto& layer) {
+        layer.parameters.map(data);
+        data += layer.parameters.size();
+      });
+    }
+  }
+
+  // Réaplatir le réseau après un redimensionnement s'il l'était
+  void keep_flat() {
+    if constexpr (is_flattenable)
+      if (!buffer.empty()) flatten();
+  }
+
   ltl::tuple_t<Layers...> layer_tuple;
+  [[no_unique_address]] buffer_type buffer;
 
 };
 
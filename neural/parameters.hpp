@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <vector>
+
+#include <eigen3/Eigen/Dense>
+
+/*******************************************************************************
+  Les paramètres d'une couche (poids, biais...) sont stockés dans un bloc
+  contigu de scalaires. Ce bloc est soit possédé par la couche, soit situé dans
+  un tampon externe (typiquement le tampon unique d'un 'Net' aplati, cf.
+  'Net::flatten'). Dans le second cas, copier la couche ne copie pas les
+  paramètres : c'est au propriétaire du tampon de relier la copie à son propre
+  tampon.
+*******************************************************************************/
+
+namespace neural {
+
+// Allocateur dont les blocs sont alignés sur une ligne de cache
+template<typename T, size_t Alignment = 64>
+struct AlignedAllocator {
+  using value_type = T;
+
+  template<typename U>
+  struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+  AlignedAllocator() = default;
+  template<typename U>
+  AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+  }
+
+  void deallocate(T* pointer, size_t) {
+    ::operator delete(pointer, std::align_val_t(Alignment));
+  }
+
+  bool operator==(const AlignedAllocator&) const = default;
+};
+
+// Identifiant stable d'un type de couche dans les fichiers de réseaux (voir
+// 'serialization.hpp'), défini à côté de chaque couche qui peut être
+// sauvegardée. Il ne dépend ni du compilateur ni de sa version.
+template<typename Layer>
+struct LayerId;
+
+// Voir 'activation.hpp'
+template<auto& ActivationFunction>
+struct ActivationId;
+
+// Composer un identifiant de couche : le numéro du type de couche, ses options
+// (8 bits) et l'identifiant de sa fonction d'activation (voir 'ActivationId')
+constexpr uint32_t make_layer_id(uint32_t kind, uint32_t options, uint32_t activation_id) {
+  return kind << 24 | options << 16 | activation_id;
+}
+
+template<typename Scalar>
+using ParameterBuffer = std::vector<Scalar, AlignedAllocator<Scalar>>;
+
+template<typename Scalar>
+class Parameters {
+public:
+  Parameters(Eigen::Index size = 0)
+    : storage(size), external_data(nullptr), parameters_nb(size) {}
+
+  //
+  Scalar*       data() { return external_data ? external_data : storage.data(); }
+  const Scalar* data() const { return external_data ? external_data : storage.data(); }
+  Eigen::Index  size() const { return parameters_nb; }
+
+  //
+  std::span<Scalar>       view() { return {data(), size_t(size())}; }
+  std::span<const Scalar> view() const { return {data(), size_t(size())}; }
+
+  // Indiquer si les paramètres sont situés dans un tampon externe
+  bool is_mapped() const { return external_data; }
+
+  // Utiliser le tampon externe 'data' (de taille 'size()') pour stocker les
+  // paramètres. Les valeurs courantes ne sont pas recopiées.
+  void map(Scalar* data) {
+    external_data = data;
+    ParameterBuffer<Scalar>().swap(storage);
+  }
+
+  // Utiliser le tampon externe 'data' en changeant le nombre de paramètres, par
+  // exemple lorsque le propriétaire du tampon a réarrangé les paramètres
+  void map(Scalar* data, Eigen::Index size) {
+    map(data);
+    parameters_nb = size;
+  }
+
+  // Changer le nombre de paramètres : les valeurs courantes sont perdues et les
+  // paramètres sont de nouveau possédés
+  void resize(Eigen::Index size) {
+    ParameterBuffer<Scalar>(size).swap(storage);
+    external_data = nullptr;
+    parameters_nb = size;
+  }
+
+private:
+  ParameterBuffer<Scalar> storage;
+  Scalar*                 external_data;
+  Eigen::Index            parameters_nb;
+};
+
+} // namespace neural
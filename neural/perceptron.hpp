@@ -1,6 +1,7 @@
 #pragma once
 
 #include <concepts>
+#include <cstddef>
 
 #include <boost/callable_traits/return_type.hpp>
 
@@ -13,6 +14,7 @@
 
 namespace neural {
 
+// Le biais est facultatif : lorsque 'bias' est vide, aucun biais n'est ajouté.
 template<typename F>
 struct Perceptron {
   using scalar = boost::callable_traits::return_type_t<F>;
@@ -27,6 +29,13 @@ struct Perceptron {
       activation_function(std::move(activation_function))
   {}
 
+  Perceptron(const Matrix<scalar>& weights, const F& activation_function,
+             const Vector<scalar>& bias)
+    : weights(weights),
+      activation_function(activation_function),
+      bias(bias)
+  {}
+
   Perceptron(Eigen::Index input_size, Eigen::Index output_size)
     : weights(output_size, input_size)
   {}
@@ -39,13 +48,13 @@ struct Perceptron {
                   "Vectorizable<scalar>, Modifying<Vector<scalar>> or "
                   "Returning<Vector<scalar>>");
     if constexpr (Vectorizable<F, scalar>) {
-      return (weights * input).unaryExpr(activation_function);
+      return preactivate(input).unaryExpr(activation_function);
     } else if constexpr (Modifying<F, Vector<scalar>>) {
-      Vector<scalar> output(weights * input);
+      Vector<scalar> output(preactivate(input));
       activation_function(output);
       return output;
     } else {
-      return activation_function(Vector<scalar>(weights * input));
+      return activation_function(preactivate(input));
     }
   }
 
@@ -57,13 +66,28 @@ struct Perceptron {
                   "Vectorizable<scalar>, Modifying<Matrix<scalar>> or "
                   "Returning<Matrix<scalar>>");
     if constexpr (Vectorizable<F, scalar>) {
-      return (weights * input).unaryExpr(activation_function);
+      return preactivate(input).unaryExpr(activation_function);
     } else if constexpr (Modifying<F, Matrix<scalar>>) {
-      Matrix<scalar> output(weights * input);
+      Matrix<scalar> output(preactivate(input));
       activation_function(output);
       return output;
     } else {
-      return activation_function(Matrix<scalar>(weights * input));
+      return activation_function(preactivate(input));
+    }
+  }
+
+  // Calculer l'image de 'input' dans 'output'. Lorsque 'output' a déjà la bonne
+  // taille, aucune allocation n'est faite (sauf si la fonction d'activation est
+  // de type Returning).
+  void propagate(const Vector<scalar>& input, Vector<scalar>& output) const {
+    output.noalias() = weights * input;
+    if (bias.size() > 0) output += bias;
+    if constexpr (Vectorizable<F, scalar>) {
+      output = output.unaryExpr(activation_function);
+    } else if constexpr (Modifying<F, Vector<scalar>>) {
+      activation_function(output);
+    } else {
+      output = activation_function(output);
     }
   }
 
@@ -77,13 +101,35 @@ struct Perceptron {
     return weights.rows();
   }
 
+  // Coût d'une inférence sur un vecteur, hors fonction d'activation
+  size_t flops() const {
+    return 2 * weights.size() + bias.size();
+  }
+  size_t parameter_bytes() const {
+    return (weights.size() + bias.size()) * sizeof(scalar);
+  }
+  size_t activation_bytes() const {
+    return weights.rows() * sizeof(scalar);
+  }
+
   //
-  void resize(Eigen::Index rows_nb, Eigen::Index columns_nb) {
-    weights.resize(rows_nb, columns_nb);
+  void resize(Eigen::Index input_size, Eigen::Index output_size) {
+    weights.resize(output_size, input_size);
+    if (bias.size() > 0) bias.resize(output_size);
   }
 
   Matrix<scalar> weights;
   F activation_function;
+  Vector<scalar> bias;
+
+private:
+  // Multiplier 'input' par la matrice de poids et ajouter le biais s'il y en a un
+  template<typename T>
+  T preactivate(const T& input) const {
+    T output = weights * input;
+    if (bias.size() > 0) output.colwise() += bias;
+    return output;
+  }
 };
 
 } // namespace neural
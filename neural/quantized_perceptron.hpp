@@ -0,0 +1,210 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+#include "ltl/operator.h"
+#include "ltl/Tuple.h"
+
+#include "linear.hpp"
+#include "net.hpp"
+#include "static_perceptron.hpp"
+
+/*******************************************************************************
+  Inférence quantifiée : une fois l'entraînement terminé, les poids d'un
+  'StaticPerceptron' peuvent être convertis en entiers sur 8 bits, avec un
+  facteur d'échelle par ligne (ie, par neurone de sortie). L'entrée est
+  quantifiée à la volée avec un facteur d'échelle unique, les produits scalaires
+  sont accumulés sur 32 bits puis remis à l'échelle avant la fonction
+  d'activation.
+*******************************************************************************/
+
+namespace neural {
+
+// Produit scalaire de deux vecteurs d'entiers sur 8 bits, accumulé sur 32 bits
+inline int32_t dot_int8(const int8_t* lhs, const int8_t* rhs, Eigen::Index size) {
+  int32_t       result = 0;
+  Eigen::Index  i = 0;
+
+#if defined(__AVX2__)
+  __m256i accumulator = _mm256_setzero_si256();
+  for (; i + 16 <= size; i += 16) {
+    auto lhs16 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(lhs + i)));
+    auto rhs16 = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rhs + i)));
+    accumulator = _mm256_add_epi32(accumulator, _mm256_madd_epi16(lhs16, rhs16));
+  }
+  auto sum128 = _mm_add_epi32(_mm256_castsi256_si128(accumulator),
+                              _mm256_extracti128_si256(accumulator, 1));
+  sum128 = _mm_hadd_epi32(sum128, sum128);
+  sum128 = _mm_hadd_epi32(sum128, sum128);
+  result = _mm_cvtsi128_si32(sum128);
+#elif defined(__SSE4_1__)
+  __m128i accumulator = _mm_setzero_si128();
+  for (; i + 8 <= size; i += 8) {
+    auto lhs16 = _mm_cvtepi8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(lhs + i)));
+    auto rhs16 = _mm_cvtepi8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(rhs + i)));
+    accumulator = _mm_add_epi32(accumulator, _mm_madd_epi16(lhs16, rhs16));
+  }
+  accumulator = _mm_hadd_epi32(accumulator, accumulator);
+  accumulator = _mm_hadd_epi32(accumulator, accumulator);
+  result = _mm_cvtsi128_si32(accumulator);
+#endif
+
+  for (; i < size; i++) result += int32_t(lhs[i]) * int32_t(rhs[i]);
+
+  return result;
+}
+
+// Le biais éventuel n'est pas quantifié : il est ajouté après la remise à
+// l'échelle.
+template<typename Scalar, auto& ActivationFunction, bool Biased = false>
+struct QuantizedPerceptron {
+  using scalar = Scalar;
+  using QuantizedMatrix = Eigen::Matrix<int8_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  using QuantizedVector = Eigen::Matrix<int8_t, Eigen::Dynamic, 1>;
+
+  // Quantifier une matrice de poids : chaque ligne est mise à l'échelle de
+  // sorte que son plus grand coefficient en valeur absolue vaille 127
+  QuantizedPerceptron(const Matrix<scalar>& real_weights, const Vector<scalar>& bias = {})
+    : weights(real_weights.rows(), real_weights.cols()),
+      scales(real_weights.rows()),
+      bias(Biased ? bias : Vector<scalar>())
+  {
+    for (Eigen::Index i = 0; i < real_weights.rows(); i++) {
+      scales[i] = scale_of(real_weights.row(i));
+      weights.row(i) = (real_weights.row(i) / scales[i]).array().round().template cast<int8_t>();
+    }
+  }
+
+  QuantizedPerceptron(Eigen::Index input_size, Eigen::Index output_size)
+    : weights(output_size, input_size),
+      scales(Vector<scalar>::Ones(output_size)),
+      bias(Vector<scalar>::Zero(Biased ? output_size : 0))
+  {}
+
+  //
+  Vector<scalar> operator<<(const Vector<scalar>& input) const {
+    using F = decltype(ActivationFunction);
+    static_assert(Vectorizable<F, scalar> || Modifying<F, Vector<scalar>>
+                  || Returning<F, Vector<scalar>>,
+                  "Activation function must satisfy one of the following : "
+                  "Vectorizable<scalar>, Modifying<Vector<scalar>> or "
+                  "Returning<Vector<scalar>>");
+    Vector<scalar> output(output_size());
+    accumulate(input, output);
+    if constexpr (Vectorizable<F, scalar>) {
+      return output.unaryExpr(std::ref(ActivationFunction));
+    } else if constexpr (Modifying<F, Vector<scalar>>) {
+      ActivationFunction(output);
+      return output;
+    } else {
+      return ActivationFunction(output);
+    }
+  }
+
+  //
+  Matrix<scalar> operator<<(const Matrix<scalar>& input) const {
+    using F = decltype(ActivationFunction);
+    static_assert(Vectorizable<F, scalar> || Modifying<F, Matrix<scalar>>
+               || Returning<F, Matrix<scalar>>,
+                  "Activation function must satisfy one of the following : "
+                  "Vectorizable<scalar>, Modifying<Matrix<scalar>> or "
+                  "Returning<Matrix<scalar>>");
+    Matrix<scalar> output(output_size(), input.cols());
+    Vector<scalar> column(output_size());
+    for (Eigen::Index j = 0; j < input.cols(); j++) {
+      accumulate(input.col(j), column);
+      output.col(j) = column;
+    }
+    if constexpr (Vectorizable<F, scalar>) {
+      return output.unaryExpr(std::ref(ActivationFunction));
+    } else if constexpr (Modifying<F, Matrix<scalar>>) {
+      ActivationFunction(output);
+      return output;
+    } else {
+      return ActivationFunction(output);
+    }
+  }
+
+  //
+  auto input_size() const {
+    return weights.cols();
+  }
+
+  //
+  auto output_size() const {
+    return weights.rows();
+  }
+
+  // Coût d'une inférence sur un vecteur, hors fonction d'activation
+  size_t flops() const {
+    return 2 * weights.size() + 2 * weights.rows() + bias.size();
+  }
+  size_t parameter_bytes() const {
+    return weights.size() * sizeof(int8_t) + (scales.size() + bias.size()) * sizeof(scalar);
+  }
+  size_t activation_bytes() const {
+    return weights.cols() * sizeof(int8_t) + weights.rows() * sizeof(scalar);
+  }
+
+  //
+  void resize(Eigen::Index input_size, Eigen::Index output_size) {
+    weights.resize(output_size, input_size);
+    scales = Vector<scalar>::Ones(output_size);
+    if constexpr (Biased) bias = Vector<scalar>::Zero(output_size);
+  }
+
+  QuantizedMatrix weights;
+  Vector<scalar>  scales;
+  Vector<scalar>  bias;
+
+private:
+  //
+  static scalar scale_of(const auto& values) {
+    auto max_coefficient = values.size() > 0 ? values.cwiseAbs().maxCoeff() : scalar(0);
+    return max_coefficient > 0 ? max_coefficient / 127 : scalar(1);
+  }
+
+  // Produit matrice-vecteur sans fonction d'activation : l'entrée est quantifiée
+  // puis chaque ligne est accumulée sur 32 bits par 'dot_int8'
+  void accumulate(const auto& input, Vector<scalar>& output) const {
+    auto            input_scale = scale_of(input);
+    QuantizedVector quantized_input = (input / input_scale).array().round().template cast<int8_t>();
+
+    for (Eigen::Index i = 0; i < output_size(); i++) {
+      auto accumulator = dot_int8(weights.row(i).data(), quantized_input.data(), input_size());
+      output[i] = accumulator * scales[i] * input_scale;
+    }
+    if constexpr (Biased) output += bias;
+  }
+};
+
+// Quantifier une couche entraînée
+template<typename Scalar, auto& ActivationFunction, bool Biased>
+auto quantize(const StaticPerceptron<Scalar, ActivationFunction, Biased>& layer) {
+  if constexpr (Biased)
+    return QuantizedPerceptron<Scalar, ActivationFunction, true>(layer.weights(), layer.bias());
+  else
+    return QuantizedPerceptron<Scalar, ActivationFunction>(layer.weights());
+}
+
+// Quantifier toutes les couches d'un réseau entraîné
+template<typename... Layers, size_t... Is>
+auto quantize(const Net<Layers...>& net, std::index_sequence<Is...>) {
+  return make_net(quantize(net[ltl::number_t<Is>()])...);
+}
+
+template<typename... Layers>
+auto quantize(const Net<Layers...>& net) {
+  return quantize(net, std::index_sequence_for<Layers...>());
+}
+
+} // namespace neural
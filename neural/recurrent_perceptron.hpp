@@ -0,0 +1,198 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+
+#include "linear.hpp"
+#include "parameters.hpp"
+
+/*******************************************************************************
+  Couche récurrente d'Elman : à chaque pas, la sortie (ou état caché) vaut
+    h(t) = F(W x(t) + U h(t - 1) + b)
+  ce qui ne coûte qu'un produit matrice-vecteur de plus qu'un 'StaticPerceptron'.
+
+  Les poids W, U et le biais éventuel b sont stockés, dans cet ordre, dans
+  'parameters' : ils font partie du génome lorsque le réseau est aplati. L'état
+  caché n'est pas stocké dans la couche mais dans sa mémoire de travail
+  ('Workspace'), qui contient deux tampons alloués une fois pour toutes et
+  échangés à chaque pas. Un même réseau peut donc piloter plusieurs épreuves en
+  même temps, et remettre l'état à zéro entre deux épreuves ne coûte qu'un
+  'setZero'.
+
+  Appliquée à une matrice, la couche traite les colonnes comme une séquence
+  temporelle partant d'un état nul.
+*******************************************************************************/
+
+namespace neural {
+
+template<typename Scalar, auto& ActivationFunction, bool Biased = false>
+struct RecurrentPerceptron {
+  using scalar = Scalar;
+
+  static constexpr bool is_biased = Biased;
+
+  // Etat caché de la couche : 'output' est l'état courant, 'previous' celui du
+  // pas précédent
+  struct Workspace {
+    Workspace(Eigen::Index output_size)
+      : output(Vector<scalar>::Zero(output_size)),
+        previous(Vector<scalar>::Zero(output_size))
+    {}
+
+    void reset() {
+      output.setZero();
+    }
+
+    Vector<scalar> output;
+    Vector<scalar> previous;
+  };
+
+  RecurrentPerceptron(const Matrix<scalar>& weights, const Matrix<scalar>& recurrent_weights)
+    : RecurrentPerceptron(weights.cols(), weights.rows())
+  {
+    this->weights() = weights;
+    this->recurrent_weights() = recurrent_weights;
+  }
+
+  RecurrentPerceptron(const Matrix<scalar>& weights, const Matrix<scalar>& recurrent_weights,
+                      const Vector<scalar>& bias) requires Biased
+    : RecurrentPerceptron(weights, recurrent_weights)
+  {
+    this->bias() = bias;
+  }
+
+  RecurrentPerceptron(Eigen::Index input_size, Eigen::Index output_size)
+    : parameters(parameters_nb(input_size, output_size)),
+      rows_nb(output_size),
+      columns_nb(input_size)
+  {}
+
+  // Accéder à la matrice de poids appliquée à l'entrée
+  Eigen::Map<Matrix<scalar>> weights() {
+    return {parameters.data(), rows_nb, columns_nb};
+  }
+  Eigen::Map<const Matrix<scalar>> weights() const {
+    return {parameters.data(), rows_nb, columns_nb};
+  }
+
+  // Accéder à la matrice de poids appliquée à l'état caché précédent
+  Eigen::Map<Matrix<scalar>> recurrent_weights() {
+    return {parameters.data() + rows_nb * columns_nb, rows_nb, rows_nb};
+  }
+  Eigen::Map<const Matrix<scalar>> recurrent_weights() const {
+    return {parameters.data() + rows_nb * columns_nb, rows_nb, rows_nb};
+  }
+
+  // Accéder au vecteur de biais
+  Eigen::Map<Vector<scalar>> bias() requires Biased {
+    return {parameters.data() + rows_nb * (columns_nb + rows_nb), rows_nb};
+  }
+  Eigen::Map<const Vector<scalar>> bias() const requires Biased {
+    return {parameters.data() + rows_nb * (columns_nb + rows_nb), rows_nb};
+  }
+
+  // Calculer un pas à partir d'un état nul
+  Vector<scalar> operator<<(const Vector<scalar>& input) const {
+    Workspace workspace(output_size());
+    propagate(input, workspace);
+    return workspace.output;
+  }
+
+  // Calculer la séquence des états cachés, chaque colonne de 'input' étant
+  // l'entrée d'un pas
+  Matrix<scalar> operator<<(const Matrix<scalar>& input) const {
+    Matrix<scalar> output(output_size(), input.cols());
+    Workspace      workspace(output_size());
+    Vector<scalar> column(input_size());
+    for (Eigen::Index j = 0; j < input.cols(); j++) {
+      column = input.col(j);
+      propagate(column, workspace);
+      output.col(j) = workspace.output;
+    }
+    return output;
+  }
+
+  // Calculer un pas : l'état courant de 'workspace' devient l'état précédent et
+  // le nouvel état est calculé sans allocation (sauf si la fonction d'activation
+  // est de type Returning)
+  void propagate(const Vector<scalar>& input, Workspace& workspace) const {
+    using F = decltype(ActivationFunction);
+    static_assert(Vectorizable<F, scalar> || Modifying<F, Vector<scalar>>
+                  || Returning<F, Vector<scalar>>,
+                  "Activation function must satisfy one of the following : "
+                  "Vectorizable<scalar>, Modifying<Vector<scalar>> or "
+                  "Returning<Vector<scalar>>");
+    auto& output = workspace.output;
+    output.swap(workspace.previous);
+    output.noalias() = weights() * input;
+    output.noalias() += recurrent_weights() * workspace.previous;
+    if constexpr (Vectorizable<F, scalar>) {
+      if constexpr (Biased)
+        output = (output + bias()).unaryExpr(std::ref(ActivationFunction));
+      else
+        output = output.unaryExpr(std::ref(ActivationFunction));
+    } else {
+      if constexpr (Biased) output += bias();
+      if constexpr (Modifying<F, Vector<scalar>>)
+        ActivationFunction(output);
+      else
+        output = ActivationFunction(output);
+    }
+  }
+
+  //
+  auto input_size() const {
+    return columns_nb;
+  }
+
+  //
+  auto output_size() const {
+    return rows_nb;
+  }
+
+  // Coût d'une inférence sur un vecteur, hors fonction d'activation
+  size_t flops() const {
+    return 2 * rows_nb * (columns_nb + rows_nb) + (Biased ? rows_nb : 0);
+  }
+  size_t parameter_bytes() const {
+    return parameters.size() * sizeof(scalar);
+  }
+  size_t activation_bytes() const {
+    return 2 * rows_nb * sizeof(scalar);
+  }
+
+  //
+  void resize(Eigen::Index input_size, Eigen::Index output_size) {
+    parameters.resize(parameters_nb(input_size, output_size));
+    rows_nb = output_size;
+    columns_nb = input_size;
+  }
+
+  // Changer la forme de la couche en utilisant 'data', déjà rangé pour cette
+  // forme, comme stockage externe des paramètres (voir 'map_net')
+  void map(scalar* data, Eigen::Index input_size, Eigen::Index output_size) {
+    parameters.map(data, parameters_nb(input_size, output_size));
+    rows_nb = output_size;
+    columns_nb = input_size;
+  }
+
+  // Nombre de paramètres d'une couche de cette forme
+  static Eigen::Index parameters_nb(Eigen::Index input_size, Eigen::Index output_size) {
+    return output_size * (input_size + output_size) + (Biased ? output_size : 0);
+  }
+
+  Parameters<scalar> parameters;
+
+private:
+  Eigen::Index rows_nb;
+  Eigen::Index columns_nb;
+};
+
+//
+template<typename Scalar, auto& ActivationFunction, bool Biased>
+struct LayerId<RecurrentPerceptron<Scalar, ActivationFunction, Biased>> {
+  static constexpr uint32_t value = make_layer_id(3, Biased, ActivationId<ActivationFunction>::value);
+};
+
+} // namespace neural
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "activation.hpp"
+#include "net.hpp"
+
+/*******************************************************************************
+  Sauvegarde des réseaux entraînés. Le format binaire est le suivant (ordre des
+  octets de la machine) :
+  - un en-tête 'FileHeader' : signature "GANN", version du format, taille d'un
+    scalaire et nombre de couches ;
+  - un en-tête 'LayerHeader' par couche : tailles d'entrée et de sortie, nombre
+    de paramètres, position du bloc de paramètres dans le fichier et identifiant
+    du type de la couche, qui comprend sa fonction d'activation (voir
+    'LayerId' ; depuis la version 3, il ne dépend plus du compilateur) ;
+  - les blocs de paramètres, chacun commençant à une position multiple de 64,
+    dans l'ordre de rangement des couches (depuis la version 2, les paramètres
+    d'un 'StaticPerceptron' sont rangés neurone par neurone).
+  Grâce à cet alignement, un fichier projeté en mémoire par 'MappedFile' peut
+  être utilisé directement comme stockage par les couches ('map_net'), sans
+  copie : plusieurs processus qui chargent le même fichier partagent alors les
+  mêmes pages.
+
+  Les en-têtes d'un fichier sont entièrement vérifiés (type des couches, tailles,
+  position et taille de chaque bloc par rapport à celle du fichier) avant la
+  construction de la moindre couche : un fichier corrompu lève une exception au
+  lieu de provoquer une allocation démesurée.
+*******************************************************************************/
+
+namespace neural {
+
+struct FileHeader {
+  char     magic[4];
+  uint32_t version;
+  uint32_t scalar_size;
+  uint32_t layers_nb;
+};
+
+struct LayerHeader {
+  uint64_t input_size;
+  uint64_t output_size;
+  uint64_t parameters_nb;
+  uint64_t offset;
+  uint32_t type_id;
+  uint32_t reserved;
+};
+
+inline constexpr char     file_magic[4] = {'G', 'A', 'N', 'N'};
+inline constexpr uint32_t file_version = 3;
+inline constexpr uint64_t block_alignment = 64;
+
+// Taille maximale d'une intercouche lue dans un fichier : elle garantit que le
+// nombre de paramètres calculé à partir d'un en-tête corrompu ne déborde pas
+inline constexpr uint64_t max_layer_size = uint64_t(1) << 24;
+
+// Une couche peut être sauvegardée si elle a un identifiant stable, si son
+// nombre de paramètres se calcule à partir de sa forme, sans la construire, et
+// si elle peut prendre une forme en utilisant directement un bloc de
+// paramètres externe
+template<typename T>
+concept Serializable = Mappable<T> && requires(T t, typename T::scalar* data, Eigen::Index n) {
+  { LayerId<T>::value } -> std::convertible_to<uint32_t>;
+  { T::parameters_nb(n, n) } -> std::convertible_to<Eigen::Index>;
+  t.map(data, n, n);
+};
+
+//
+constexpr uint64_t align_offset(uint64_t offset) {
+  return (offset + block_alignment - 1) / block_alignment * block_alignment;
+}
+
+// Projeter un fichier en mémoire. Les pages sont partagées tant qu'elles ne
+// sont pas modifiées (une écriture ne touche pas au fichier).
+class MappedFile {
+public:
+  explicit MappedFile(const std::filesystem::path& path) {
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+      throw std::system_error(errno, std::generic_category(), path.string());
+
+    struct stat status;
+    if (::fstat(descriptor, &status) < 0) {
+      ::close(descriptor);
+      throw std::system_error(errno, std::generic_category(), path.string());
+    }
+    length = status.st_size;
+
+    address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (address == MAP_FAILED)
+      throw std::system_error(errno, std::generic_category(), path.string());
+  }
+
+  MappedFile(MappedFile&& other)
+    : address(std::exchange(other.address, MAP_FAILED)),
+      length(std::exchange(other.length, 0))
+  {}
+
+  MappedFile& operator=(MappedFile&& other) {
+    std::swap(address, other.address);
+    std::swap(length, other.length);
+    return *this;
+  }
+
+  ~MappedFile() {
+    if (address != MAP_FAILED) ::munmap(address, length);
+  }
+
+  //
+  std::byte* data() { return static_cast<std::byte*>(address); }
+  size_t     size() const { return length; }
+
+private:
+  void*  address = MAP_FAILED;
+  size_t length = 0;
+};
+
+// Vérifier que l'en-tête d'un fichier correspond au type du réseau, avant de
+// lire les en-têtes des couches dont il donne le nombre
+template<typename... Layers>
+void check_file_header(std::type_identity<Net<Layers...>>, const FileHeader& file_header) {
+  using scalar = typename std::tuple_element_t<0, std::tuple<Layers...>>::scalar;
+
+  if (!std::equal(file_header.magic, file_header.magic + 4, file_magic))
+    throw std::runtime_error("Not a network file");
+  if (file_header.version != file_version)
+    throw std::runtime_error("Unsupported network file version");
+  if (file_header.scalar_size != sizeof(scalar) || file_header.layers_nb != sizeof...(Layers))
+    throw std::runtime_error("Network file does not match the network type");
+}
+
+// Vérifier que les en-têtes des couches correspondent au type du réseau et que
+// les blocs de paramètres se suivent, après les en-têtes, dans les 'data_size'
+// octets du fichier
+template<Serializable... Layers>
+void check_layer_headers(std::type_identity<Net<Layers...>>, const std::vector<LayerHeader>& layer_headers,
+                         uint64_t data_size) {
+  using scalar = typename std::tuple_element_t<0, std::tuple<Layers...>>::scalar;
+  constexpr std::array type_ids {LayerId<Layers>::value...};
+  constexpr std::array parameters_nb_ftors {&Layers::parameters_nb...};
+
+  uint64_t end = sizeof(FileHeader) + layer_headers.size() * sizeof(LayerHeader);
+  for (size_t i = 0; i < layer_headers.size(); i++) {
+    const auto& layer_header = layer_headers[i];
+    if (layer_header.type_id != type_ids[i]
+     || (i > 0 && layer_header.input_size != layer_headers[i - 1].output_size)
+     || layer_header.input_size > max_layer_size
+     || layer_header.output_size > max_layer_size
+     || layer_header.offset % block_alignment != 0)
+      throw std::runtime_error("Network file does not match the network type");
+
+    Eigen::Index parameters_nb;
+    try {
+      parameters_nb = parameters_nb_ftors[i](layer_header.input_size, layer_header.output_size);
+    } catch (const std::invalid_argument&) {
+      throw std::runtime_error("Network file does not match the network type");
+    }
+    if (uint64_t(parameters_nb) != layer_header.parameters_nb)
+      throw std::runtime_error("Network file does not match the network type");
+
+    if (layer_header.offset < end)
+      throw std::runtime_error("Overlapping blocks in network file");
+    if (layer_header.offset > data_size
+     || layer_header.parameters_nb > (data_size - layer_header.offset) / sizeof(scalar))
+      throw std::runtime_error("Truncated network file");
+    end = layer_header.offset + layer_header.parameters_nb * sizeof(scalar);
+  }
+}
+
+// Tailles des intercouches décrites par les en-têtes des couches
+inline std::vector<int64_t> get_layer_sizes(const std::vector<LayerHeader>& layer_headers) {
+  std::vector<int64_t> layer_sizes {int64_t(layer_headers.front().input_size)};
+  for (const auto& layer_header : layer_headers) layer_sizes.push_back(layer_header.output_size);
+  return layer_sizes;
+}
+
+// Nombre d'octets restant dans un flux, ou la plus grande taille possible si le
+// flux ne permet pas de se déplacer
+inline uint64_t get_remaining_size(std::istream& in_stream) {
+  auto position = in_stream.tellg();
+  if (position < 0) return std::numeric_limits<uint64_t>::max();
+  in_stream.seekg(0, std::ios::end);
+  auto end = in_stream.tellg();
+  in_stream.seekg(position);
+  return end < position ? std::numeric_limits<uint64_t>::max() : uint64_t(end - position);
+}
+
+// Ecrire un réseau dans un flux binaire
+template<Serializable... Layers>
+void save(const Net<Layers...>& net, std::ostream& out_stream) {
+  using scalar = typename std::tuple_element_t<0, std::tuple<Layers...>>::scalar;
+
+  FileHeader file_header {
+    .magic = {file_magic[0], file_magic[1], file_magic[2], file_magic[3]},
+    .version = file_version,
+    .scalar_size = sizeof(scalar),
+    .layers_nb = sizeof...(Layers)
+  };
+  constexpr std::array type_ids {LayerId<Layers>::value...};
+
+  std::vector<LayerHeader> layer_headers;
+  uint64_t offset = align_offset(sizeof(FileHeader) + sizeof...(Layers) * sizeof(LayerHeader));
+  net.for_each([&](const auto& layer) {
+    layer_headers.push_back({
+      .input_size = uint64_t(layer.input_size()),
+      .output_size = uint64_t(layer.output_size()),
+      .parameters_nb = uint64_t(layer.parameters.size()),
+      .offset = offset,
+      .type_id = type_ids[layer_headers.size()],
+      .reserved = 0
+    });
+    offset = align_offset(offset + layer.parameters.size() * sizeof(scalar));
+  });
+
+  out_stream.write(reinterpret_cast<const char*>(&file_header), sizeof(FileHeader));
+  out_stream.write(reinterpret_cast<const char*>(layer_headers.data()),
+                   layer_headers.size() * sizeof(LayerHeader));
+
+  uint64_t position = sizeof(FileHeader) + layer_headers.size() * sizeof(LayerHeader);
+  size_t   i = 0;
+  net.for_each([&](const auto& layer) {
+    const auto& layer_header = layer_headers[i++];
+    for (; position < layer_header.offset; position++) out_stream.put(0);
+    out_stream.write(reinterpret_cast<const char*>(layer.parameters.data()),
+                     layer.parameters.size() * sizeof(scalar));
+    position += layer.parameters.size() * sizeof(scalar);
+  });
+
+  if (!out_stream) throw std::runtime_error("Failed to write network");
+}
+
+template<Serializable... Layers>
+void save(const Net<Layers...>& net, const std::filesystem::path& path) {
+  std::ofstream out_stream(path, std::ios::binary);
+  save(net, out_stream);
+}
+
+// Lire un réseau depuis un flux binaire. Les paramètres sont copiés dans le
+// tampon du réseau, qui est retourné aplati.
+template<typename NetType>
+NetType load(std::istream& in_stream) {
+  auto data_size = get_remaining_size(in_stream);
+  FileHeader file_header;
+  in_stream.read(reinterpret_cast<char*>(&file_header), sizeof(FileHeader));
+  if (!in_stream) throw std::runtime_error("Not a network file");
+  check_file_header(std::type_identity<NetType>(), file_header);
+
+  std::vector<LayerHeader> layer_headers(file_header.layers_nb);
+  in_stream.read(reinterpret_cast<char*>(layer_headers.data()),
+                 layer_headers.size() * sizeof(LayerHeader));
+  if (!in_stream) throw std::runtime_error("Not a network file");
+  check_layer_headers(std::type_identity<NetType>(), layer_headers, data_size);
+
+  NetType net(get_layer_sizes(layer_headers));
+  net.flatten();
+
+  uint64_t position = sizeof(FileHeader) + layer_headers.size() * sizeof(LayerHeader);
+  size_t   i = 0;
+  net.for_each([&](auto& layer) {
+    using scalar = typename std::decay_t<decltype(layer)>::scalar;
+    const auto& layer_header = layer_headers[i++];
+    in_stream.ignore(layer_header.offset - position);
+    in_stream.read(reinterpret_cast<char*>(layer.parameters.data()),
+                   layer.parameters.size() * sizeof(scalar));
+    position = layer_header.offset + layer.parameters.size() * sizeof(scalar);
+  });
+  if (!in_stream) throw std::runtime_error("Truncated network file");
+
+  return net;
+}
+
+template<typename NetType>
+NetType load(const std::filesystem::path& path) {
+  std::ifstream in_stream(path, std::ios::binary);
+  if (!in_stream) throw std::runtime_error("Cannot open " + path.string());
+  return load<NetType>(in_stream);
+}
+
+// Construire un réseau dont les couches utilisent directement les paramètres
+// d'un fichier projeté en mémoire : les couches sont construites vides, puis
+// prennent leur forme sur leur bloc du fichier, sans allouer ni recopier leurs
+// paramètres. Le réseau retourné, ainsi que ses copies, ne doit pas survivre à
+// 'file'.
+template<typename NetType>
+NetType map_net(MappedFile& file) {
+  FileHeader file_header;
+  if (file.size() < sizeof(FileHeader)) throw std::runtime_error("Not a network file");
+  std::copy_n(file.data(), sizeof(FileHeader), reinterpret_cast<std::byte*>(&file_header));
+
+  check_file_header(std::type_identity<NetType>(), file_header);
+  if (file.size() < sizeof(FileHeader) + file_header.layers_nb * sizeof(LayerHeader))
+    throw std::runtime_error("Truncated network file");
+
+  std::vector<LayerHeader> layer_headers(file_header.layers_nb);
+  std::copy_n(file.data() + sizeof(FileHeader), layer_headers.size() * sizeof(LayerHeader),
+              reinterpret_cast<std::byte*>(layer_headers.data()));
+
+  check_layer_headers(std::type_identity<NetType>(), layer_headers, file.size());
+
+  NetType net(std::vector<int64_t>(layer_headers.size() + 1, 0));
+  size_t  i = 0;
+  net.for_each([&](auto& layer) {
+    using scalar = typename std::decay_t<decltype(layer)>::scalar;
+    const auto& layer_header = layer_headers[i++];
+    layer.map(reinterpret_cast<scalar*>(file.data() + layer_header.offset),
+              layer_header.input_size, layer_header.output_size);
+  });
+
+  return net;
+}
+
+} // namespace neural
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include <eigen3/Eigen/SparseCore>
+
+#include "ltl/operator.h"
+#include "ltl/Tuple.h"
+
+#include "linear.hpp"
+#include "net.hpp"
+#include "static_perceptron.hpp"
+
+/*******************************************************************************
+  Couches creuses : lorsque la plupart des poids d'une couche entraînée sont
+  proches de zéro (typiquement avec de nombreux capteurs en entrée), 'prune'
+  supprime les poids de faible amplitude et convertit la couche en
+  'SparsePerceptron'. Les poids sont stockés ligne par ligne (format CSR), de
+  sorte que le coût d'une inférence est proportionnel au nombre de poids non
+  nuls. Le point à partir duquel la version creuse est plus rapide que la
+  version dense est mesuré par 'bench/sparse_perceptron.cpp' ; 'sparsity'
+  permet de décider s'il est atteint avant de convertir une couche.
+*******************************************************************************/
+
+namespace neural {
+
+template<typename Scalar>
+using SparseMatrix = Eigen::SparseMatrix<Scalar, Eigen::RowMajor>;
+
+template<typename Scalar, auto& ActivationFunction, bool Biased = false>
+struct SparsePerceptron {
+  using scalar = Scalar;
+
+  SparsePerceptron(const SparseMatrix<scalar>& weights, const Vector<scalar>& bias = {})
+    : weights(weights),
+      bias(Biased ? bias : Vector<scalar>())
+  {
+    this->weights.makeCompressed();
+  }
+
+  SparsePerceptron(Eigen::Index input_size, Eigen::Index output_size)
+    : weights(output_size, input_size),
+      bias(Vector<scalar>::Zero(Biased ? output_size : 0))
+  {}
+
+  //
+  Vector<scalar> operator<<(const Vector<scalar>& input) const {
+    using F = decltype(ActivationFunction);
+    static_assert(Vectorizable<F, scalar> || Modifying<F, Vector<scalar>>
+                  || Returning<F, Vector<scalar>>,
+                  "Activation function must satisfy one of the following : "
+                  "Vectorizable<scalar>, Modifying<Vector<scalar>> or "
+                  "Returning<Vector<scalar>>");
+    Vector<scalar> output(output_size());
+    propagate(input, output);
+    return output;
+  }
+
+  //
+  Matrix<scalar> operator<<(const Matrix<scalar>& input) const {
+    using F = decltype(ActivationFunction);
+    static_assert(Vectorizable<F, scalar> || Modifying<F, Matrix<scalar>>
+               || Returning<F, Matrix<scalar>>,
+                  "Activation function must satisfy one of the following : "
+                  "Vectorizable<scalar>, Modifying<Matrix<scalar>> or "
+                  "Returning<Matrix<scalar>>");
+    Matrix<scalar> output(weights * input);
+    if constexpr (Biased) output.colwise() += bias;
+    if constexpr (Vectorizable<F, scalar>) {
+      return output.unaryExpr(std::ref(ActivationFunction));
+    } else if constexpr (Modifying<F, Matrix<scalar>>) {
+      ActivationFunction(output);
+      return output;
+    } else {
+      return ActivationFunction(output);
+    }
+  }
+
+  // Calculer l'image de 'input' dans 'output' sans allocation lorsque 'output' a
+  // déjà la bonne taille (sauf si la fonction d'activation est de type
+  // Returning). Seuls les poids non nuls sont parcourus.
+  void propagate(const Vector<scalar>& input, Vector<scalar>& output) const {
+    using F = decltype(ActivationFunction);
+    output.noalias() = weights * input;
+    if constexpr (Vectorizable<F, scalar>) {
+      if constexpr (Biased)
+        output = (output + bias).unaryExpr(std::ref(ActivationFunction));
+      else
+        output = output.unaryExpr(std::ref(ActivationFunction));
+    } else {
+      if constexpr (Biased) output += bias;
+      if constexpr (Modifying<F, Vector<scalar>>)
+        ActivationFunction(output);
+      else
+        output = ActivationFunction(output);
+    }
+  }
+
+  //
+  auto input_size() const {
+    return weights.cols();
+  }
+
+  //
+  auto output_size() const {
+    return weights.rows();
+  }
+
+  //
+  auto nonzeros_nb() const {
+    return weights.nonZeros();
+  }
+
+  // Coût d'une inférence sur un vecteur, hors fonction d'activation
+  size_t flops() const {
+    return 2 * weights.nonZeros() + bias.size();
+  }
+  size_t parameter_bytes() const {
+    return weights.nonZeros() * (sizeof(scalar) + sizeof(typename SparseMatrix<scalar>::StorageIndex))
+         + (weights.rows() + 1) * sizeof(typename SparseMatrix<scalar>::StorageIndex)
+         + bias.size() * sizeof(scalar);
+  }
+  size_t activation_bytes() const {
+    return weights.rows() * sizeof(scalar);
+  }
+
+  //
+  void resize(Eigen::Index input_size, Eigen::Index output_size) {
+    weights.resize(output_size, input_size);
+    if constexpr (Biased) bias = Vector<scalar>::Zero(output_size);
+  }
+
+  SparseMatrix<scalar> weights;
+  Vector<scalar>       bias;
+};
+
+// Proportion des poids d'une couche dont l'amplitude ne dépasse pas 'magnitude',
+// ie, la proportion de poids que 'prune' supprimerait
+template<typename Scalar, auto& ActivationFunction, bool Biased>
+double sparsity(const StaticPerceptron<Scalar, ActivationFunction, Biased>& layer,
+                std::type_identity_t<Scalar> magnitude) {
+  auto weights = layer.weights();
+  if (weights.size() == 0) return 0;
+  return double((weights.array().abs() <= magnitude).count()) / weights.size();
+}
+
+// Supprimer les poids d'une couche entraînée dont l'amplitude ne dépasse pas
+// 'magnitude'. Le biais éventuel est conservé tel quel.
+template<typename Scalar, auto& ActivationFunction, bool Biased>
+auto prune(const StaticPerceptron<Scalar, ActivationFunction, Biased>& layer,
+           std::type_identity_t<Scalar> magnitude) {
+  auto                 weights = layer.weights();
+  SparseMatrix<Scalar> sparse_weights
+    = (weights.array().abs() > magnitude).select(weights, Scalar(0)).matrix().sparseView();
+
+  if constexpr (Biased)
+    return SparsePerceptron<Scalar, ActivationFunction, true>(sparse_weights, layer.bias());
+  else
+    return SparsePerceptron<Scalar, ActivationFunction>(sparse_weights);
+}
+
+// Elaguer toutes les couches d'un réseau entraîné avec le même seuil
+template<typename... Layers, size_t... Is>
+auto prune(const Net<Layers...>& net, auto magnitude, std::index_sequence<Is...>) {
+  return make_net(prune(net[ltl::number_t<Is>()], magnitude)...);
+}
+
+template<typename... Layers>
+auto prune(const Net<Layers...>& net, auto magnitude) {
+  return prune(net, magnitude, std::index_sequence_for<Layers...>());
+}
+
+} // namespace neural
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <concepts>
+#include <cstddef>
 #include <functional>
 
 #include <boost/callable_traits/return_type.hpp>
@@ -8,25 +9,72 @@
 #include "ltl/algos.h"
 
 #include "linear.hpp"
+#include "parameters.hpp"
 
 /*******************************************************************************
 *******************************************************************************/
 
 namespace neural {
 
+// Lorsque 'Biased' est vrai, un vecteur de biais est ajouté au produit
+// matrice-vecteur avant la fonction d'activation.
+//
+// Les paramètres sont rangés neurone par neurone : chaque ligne de la matrice de
+// poids est suivie du biais du neurone correspondant. Un neurone occupe donc
+// 'neuron_size()' valeurs contiguës de 'parameters', ce qui permet de croiser
+// des génomes neurone par neurone (voir 'Net::neurons').
 //TODO : enlever la rustine
-template<typename Scalar, auto& ActivationFunction>
+template<typename Scalar, auto& ActivationFunction, bool Biased = false>
 struct StaticPerceptron {
   using scalar = Scalar;
+  using RowMajorMatrix = Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+  using WeightsMap = Eigen::Map<RowMajorMatrix, Eigen::Unaligned, Eigen::OuterStride<>>;
+  using ConstWeightsMap = Eigen::Map<const RowMajorMatrix, Eigen::Unaligned, Eigen::OuterStride<>>;
+  using BiasMap = Eigen::Map<Vector<Scalar>, Eigen::Unaligned, Eigen::InnerStride<>>;
+  using ConstBiasMap = Eigen::Map<const Vector<Scalar>, Eigen::Unaligned, Eigen::InnerStride<>>;
+
+  static constexpr bool is_biased = Biased;
 
   StaticPerceptron(const Matrix<scalar>& weights)
-    : weights(weights)
-  {}
+    : StaticPerceptron(weights.cols(), weights.rows())
+  {
+    this->weights() = weights;
+  }
+
+  StaticPerceptron(const Matrix<scalar>& weights, const Vector<scalar>& bias) requires Biased
+    : StaticPerceptron(weights)
+  {
+    this->bias() = bias;
+  }
 
   StaticPerceptron(Eigen::Index input_size, Eigen::Index output_size)
-    : weights(output_size, input_size)
+    : parameters(parameters_nb(input_size, output_size)),
+      rows_nb(output_size),
+      columns_nb(input_size)
   {}
 
+  // Accéder à la matrice de poids, stockée ligne par ligne dans 'parameters'
+  WeightsMap weights() {
+    return {parameters.data(), rows_nb, columns_nb, Eigen::OuterStride<>(neuron_size())};
+  }
+  ConstWeightsMap weights() const {
+    return {parameters.data(), rows_nb, columns_nb, Eigen::OuterStride<>(neuron_size())};
+  }
+
+  // Accéder au vecteur de biais, dont chaque coefficient suit la ligne de poids
+  // du neurone correspondant
+  BiasMap bias() requires Biased {
+    return {parameters.data() + columns_nb, rows_nb, Eigen::InnerStride<>(neuron_size())};
+  }
+  ConstBiasMap bias() const requires Biased {
+    return {parameters.data() + columns_nb, rows_nb, Eigen::InnerStride<>(neuron_size())};
+  }
+
+  // Nombre de paramètres d'un neurone : ses poids et son biais éventuel
+  Eigen::Index neuron_size() const {
+    return columns_nb + (Biased ? 1 : 0);
+  }
+
   //
   Vector<scalar> operator<<(const Vector<scalar>& input) const {
     using F = decltype(ActivationFunction);
@@ -35,15 +83,9 @@ struct StaticPerceptron {
                   "Activation function must satisfy one of the following : "
                   "Vectorizable<scalar>, Modifying<Vector<scalar>> or "
                   "Returning<Vector<scalar>>");
-    if constexpr (Vectorizable<F, scalar>) {
-      return (weights * input).unaryExpr(std::ref(ActivationFunction));
-    } else if constexpr (Modifying<F, Vector<scalar>>) {
-      Vector<scalar> output(weights * input);
-      ActivationFunction(output);
-      return output;
-    } else {
-      return ActivationFunction(Vector<scalar>(weights * input));
-    }
+    Vector<scalar> output(output_size());
+    propagate(input, output);
+    return output;
   }
 
   //
@@ -54,33 +96,91 @@ struct StaticPerceptron {
                   "Activation function must satisfy one of the following : "
                   "Vectorizable<scalar>, Modifying<Matrix<scalar>> or "
                   "Returning<Matrix<scalar>>");
+    Matrix<scalar> output(weights() * input);
+    if constexpr (Biased) output.colwise() += bias();
     if constexpr (Vectorizable<F, scalar>) {
-      return (weights * input).unaryExpr(std::ref(ActivationFunction));
+      return output.unaryExpr(std::ref(ActivationFunction));
     } else if constexpr (Modifying<F, Matrix<scalar>>) {
-      Matrix<scalar> output(weights * input);
       ActivationFunction(output);
       return output;
     } else {
-      return ActivationFunction(Matrix<scalar>(weights * input));
+      return ActivationFunction(output);
+    }
+  }
+
+  // Calculer l'image de 'input' dans 'output'. Lorsque 'output' a déjà la bonne
+  // taille, aucune allocation n'est faite (sauf si la fonction d'activation est
+  // de type Returning). Pour une fonction d'activation vectorisable, l'ajout du
+  // biais et l'activation sont faits en un seul passage sur 'output'.
+  void propagate(const Vector<scalar>& input, Vector<scalar>& output) const {
+    using F = decltype(ActivationFunction);
+    output.noalias() = weights() * input;
+    if constexpr (Vectorizable<F, scalar>) {
+      if constexpr (Biased)
+        output = (output + bias()).unaryExpr(std::ref(ActivationFunction));
+      else
+        output = output.unaryExpr(std::ref(ActivationFunction));
+    } else {
+      if constexpr (Biased) output += bias();
+      if constexpr (Modifying<F, Vector<scalar>>)
+        ActivationFunction(output);
+      else
+        output = ActivationFunction(output);
     }
   }
 
   //
   auto input_size() const {
-    return weights.cols();
+    return columns_nb;
   }
 
   //
   auto output_size() const {
-    return weights.rows();
+    return rows_nb;
+  }
+
+  // Coût d'une inférence sur un vecteur, hors fonction d'activation
+  size_t flops() const {
+    return 2 * rows_nb * columns_nb + (Biased ? rows_nb : 0);
+  }
+  size_t parameter_bytes() const {
+    return parameters.size() * sizeof(scalar);
+  }
+  size_t activation_bytes() const {
+    return rows_nb * sizeof(scalar);
   }
 
   //
-  void resize(Eigen::Index rows_nb, Eigen::Index columns_nb) {
-    weights.resize(rows_nb, columns_nb);
+  void resize(Eigen::Index input_size, Eigen::Index output_size) {
+    parameters.resize(parameters_nb(input_size, output_size));
+    rows_nb = output_size;
+    columns_nb = input_size;
+  }
+
+  // Changer la forme de la couche en utilisant 'data', déjà rangé pour cette
+  // forme, comme stockage externe des paramètres (voir 'Net::grow')
+  void map(scalar* data, Eigen::Index input_size, Eigen::Index output_size) {
+    parameters.map(data, parameters_nb(input_size, output_size));
+    rows_nb = output_size;
+    columns_nb = input_size;
+  }
+
+  // Nombre de paramètres d'une couche de cette forme
+  static Eigen::Index parameters_nb(Eigen::Index input_size, Eigen::Index output_size) {
+    return output_size * (input_size + (Biased ? 1 : 0));
   }
 
-  Matrix<scalar> weights;
+  Parameters<scalar> parameters;
+
+private:
+  Eigen::Index rows_nb;
+  Eigen::Index columns_nb;
+};
+
+//
+template<typename Scalar, auto& ActivationFunction, bool Biased>
+struct LayerId<StaticPerceptron<Scalar, ActivationFunction, Biased>> {
+  static constexpr uint32_t value = make_layer_id(1, Biased, ActivationId<ActivationFunction>::value);
 };
 
 } // namespace neural
@@ -0,0 +1,54 @@
+#include <catch.hpp>
+#include "../activation.hpp"
+
+#include <cmath>
+
+#include "../static_perceptron.hpp"
+
+using namespace neural;
+
+TEST_CASE("Tabulated : approcher une fonction d'activation par interpolation") {
+  SECTION("L'erreur absolue de 'tabulated_sigmoid' reste sous la borne "
+          "documentée, y compris hors de l'intervalle tabulé") {
+    double max_error = 0;
+    for (double x = -40; x <= 40; x += 1e-3)
+      max_error = std::max(max_error, std::abs(tabulated_sigmoid<double>(x) - sigmoid(x)));
+
+    REQUIRE(max_error < 2e-5);
+  }
+
+  SECTION("L'erreur absolue de 'tabulated_tanh' reste sous la borne documentée, "
+          "y compris hors de l'intervalle tabulé") {
+    double max_error = 0;
+    for (double x = -40; x <= 40; x += 1e-3)
+      max_error = std::max(max_error, std::abs(tabulated_tanh<double>(x) - std::tanh(x)));
+
+    REQUIRE(max_error < 3e-5);
+  }
+
+  SECTION("En simple précision, les bornes sont les mêmes") {
+    float max_error = 0;
+    for (float x = -40; x <= 40; x += 1e-3f)
+      max_error = std::max(max_error, std::abs(tabulated_sigmoid<float>(x) - sigmoid(x)));
+
+    REQUIRE(max_error < 2e-5f);
+  }
+
+  SECTION("Les entrées infinies sont saturées, et NaN donne la valeur de la "
+          "borne inférieure") {
+    REQUIRE(tabulated_sigmoid<double>(INFINITY) == Approx(1).margin(2e-5));
+    REQUIRE(tabulated_sigmoid<double>(-INFINITY) == Approx(0).margin(2e-5));
+    REQUIRE(tabulated_tanh<float>(NAN) == tabulated_tanh<float>(-INFINITY));
+    REQUIRE(tabulated_sigmoid<double>(std::nextafter(16., 0.)) == Approx(sigmoid(16.)).margin(2e-5));
+  }
+
+  SECTION("Une fonction tabulée peut servir de fonction d'activation à un "
+          "'StaticPerceptron'") {
+    Matrix<float> weights = Matrix<float>::Random(4, 3);
+    Vector<float> input = Vector<float>::Random(3);
+    StaticPerceptron<float, tabulated_sigmoid<float>> layer(weights);
+    StaticPerceptron<float, sigmoid<float>>           exact_layer(weights);
+
+    REQUIRE(((layer << input) - (exact_layer << input)).cwiseAbs().maxCoeff() < 2e-5f);
+  }
+}
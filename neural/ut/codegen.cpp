@@ -0,0 +1,40 @@
+#include <catch.hpp>
+#include "generated_net.hpp"
+
+#include <random>
+
+#include "codegen_net.hpp"
+
+using namespace neural;
+
+TEST_CASE("generate_header : générer le code d'inférence d'un réseau entraîné") {
+  auto net = make_codegen_net();
+
+  SECTION("Les tailles d'entrée et de sortie du code généré sont celles du réseau") {
+    REQUIRE(generated_net::input_size == net[0_n].input_size());
+    REQUIRE(generated_net::output_size == net[1_n].output_size());
+  }
+
+  SECTION("Les poids sont reproduits exactement") {
+    for (int i = 0; i < 15; i++)
+      for (int j = 0; j < 4; j++)
+        REQUIRE(generated_net::weights0[i][j] == net[0_n].weights()(i, j));
+  }
+
+  SECTION("Pour une même entrée, la fonction 'forward' générée donne le même "
+          "résultat que le réseau, aux erreurs d'arrondi près") {
+    std::mt19937                          rnd_engine(42);
+    std::uniform_real_distribution<float> pick_value(-5, 5);
+
+    for (int k = 0; k < 1000; k++) {
+      Vector<float> input(4);
+      for (auto& value : input) value = pick_value(rnd_engine);
+
+      Vector<float> expected = net << input;
+      float         output[3];
+      generated_net::forward(input.data(), output);
+
+      for (int i = 0; i < 3; i++) REQUIRE(output[i] == Approx(expected[i]).margin(1e-5));
+    }
+  }
+}
@@ -0,0 +1,10 @@
+#include <iostream>
+
+#include "../codegen.hpp"
+#include "codegen_net.hpp"
+
+// Ecrire sur la sortie standard l'en-tête généré à partir de 'make_codegen_net'
+int main() {
+  neural::generate_header(make_codegen_net(), std::cout, "generated_net");
+  return 0;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <random>
+
+#include "../activation.hpp"
+#include "../net.hpp"
+#include "../static_perceptron.hpp"
+
+/*******************************************************************************
+  Réseau utilisé par le test d'équivalence de 'generate_header' : il est
+  reconstruit à l'identique par le générateur et par le test grâce à une graine
+  fixe.
+*******************************************************************************/
+
+using CodegenNet = neural::Net<
+  neural::StaticPerceptron<float, neural::relu<float>, true>,
+  neural::StaticPerceptron<float, neural::sigmoid<float>, true>
+>;
+
+inline CodegenNet make_codegen_net() {
+  std::mt19937                    rnd_engine(1337);
+  std::normal_distribution<float> make_noise(0, 1);
+
+  auto net = CodegenNet {4, 15, 3};
+  net.flatten();
+  for (auto& weight : net.parameters()) weight = make_noise(rnd_engine);
+
+  return net;
+}
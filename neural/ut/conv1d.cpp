@@ -0,0 +1,99 @@
+#include <catch.hpp>
+#include "../conv1d.hpp"
+
+#include <random>
+
+#include "../net.hpp"
+#include "../static_perceptron.hpp"
+
+using namespace neural;
+
+float identity(float x) { return x; }
+
+TEST_CASE("Conv1D : convoluer un anneau de capteurs") {
+  std::mt19937                    rnd_engine(1337);
+  std::normal_distribution<float> make_noise(0, 1);
+
+  SECTION("Le remplissage est circulaire : le premier et le dernier capteur sont "
+          "voisins") {
+    Matrix<float> weights(1, 3);
+    weights << 1, 10, 100;
+    Conv1D<float, identity, 3> layer(weights, 4);
+    Vector<float> input(4);
+    input << 1, 2, 3, 4;
+    Vector<float> output(4);
+    output << 4 + 10 + 200, 1 + 20 + 300, 2 + 30 + 400, 3 + 40 + 100;
+
+    REQUIRE((layer << input) == output);
+  }
+
+  SECTION("Le remplissage reste circulaire lorsque l'entrée est plus étroite "
+          "que le noyau") {
+    Matrix<float> weights = Matrix<float>::Zero(1, 7);
+    weights(0, 0) = 1; // Décalage de -3
+    Conv1D<float, identity, 7> layer(weights, 2);
+    Vector<float> input(2);
+    input << 1, 2;
+    Vector<float> output(2);
+    output << 2, 1;
+
+    REQUIRE((layer << input) == output);
+  }
+
+  SECTION("Chaque canal de sortie applique son propre noyau et son biais à toutes "
+          "les positions de l'entrée, ce qui donne la même sortie qu'un calcul "
+          "naïf avec modulo") {
+    Conv1D<float, identity, 5, true> layer(36, 3 * 36);
+    for (auto& parameter : layer.parameters.view()) parameter = make_noise(rnd_engine);
+    Vector<float> input(36);
+    for (auto& value : input) value = make_noise(rnd_engine);
+
+    Vector<float> output = layer << input;
+    for (int channel = 0; channel < 3; channel++)
+      for (int i = 0; i < 36; i++) {
+        float expected = layer.bias()[channel];
+        for (int k = 0; k < 5; k++)
+          expected += layer.weights()(channel, k) * input[(i + k - 2 + 36) % 36];
+        REQUIRE(output[channel * 36 + i] == Approx(expected).margin(1e-5));
+      }
+  }
+
+  SECTION("Les poids sont partagés entre les positions : la couche a bien moins "
+          "de paramètres qu'un perceptron de même forme") {
+    Conv1D<float, identity, 5, true> layer(360, 4 * 360);
+
+    REQUIRE(layer.input_size() == 360);
+    REQUIRE(layer.output_size() == 4 * 360);
+    REQUIRE(layer.parameters.size() == 4 * 5 + 4);
+  }
+
+  SECTION("La taille de sortie doit être un multiple de la taille d'entrée") {
+    REQUIRE_THROWS_AS((Conv1D<float, identity, 3>(10, 15)), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Conv1D : utiliser une convolution dans un Net") {
+  auto net = Net<Conv1D<float, identity, 3, true>, StaticPerceptron<float, identity>> {8, 16, 2};
+  net.flatten();
+  for (size_t i = 0; i < net.parameters().size(); i++) net.parameters()[i] = (i % 5) / 4.f - 0.5f;
+  Vector<float> input = Vector<float>::Random(8);
+
+  SECTION("Les noyaux et les biais font partie des paramètres du réseau aplati") {
+    REQUIRE(net.parameters().size() == 2 * 3 + 2 + 2 * 16);
+    REQUIRE(net[1_n].parameters.data() == net.parameters().data() + 2 * 3 + 2);
+  }
+
+  SECTION("'propagate' et l'opérateur << donnent le même résultat") {
+    auto workspace = net.make_workspace();
+
+    REQUIRE(net.propagate(input, workspace) == (net << input));
+  }
+
+  SECTION("Une matrice d'entrées est traitée colonne par colonne") {
+    Matrix<float> inputs = Matrix<float>::Random(8, 3);
+    Matrix<float> outputs = net << inputs;
+
+    for (int j = 0; j < 3; j++)
+      REQUIRE((outputs.col(j) - (net << Vector<float>(inputs.col(j)))).cwiseAbs().maxCoeff() < 1e-5);
+  }
+}
@@ -0,0 +1,73 @@
+#include <catch.hpp>
+#include "../cost.hpp"
+
+#include "../fixed_perceptron.hpp"
+#include "../net.hpp"
+#include "../recurrent_perceptron.hpp"
+#include "../static_perceptron.hpp"
+
+using namespace neural;
+
+template<typename Scalar = float>
+Scalar identity(Scalar x) { return x; }
+
+TEST_CASE("FixedPerceptron : calculer avec une forme connue à la compilation") {
+  auto net = Net<FixedPerceptron<float, identity<float>, 3, 4, true>, StaticPerceptron<float, identity<float>>> {3, 4, 2};
+  net.flatten();
+  for (size_t i = 0; i < net.parameters().size(); i++) net.parameters()[i] = (i % 5) / 4.f - 0.5f;
+  Vector<float> input(3);
+  input << 1, 2, 3;
+
+  SECTION("Les poids et le biais font partie des paramètres du réseau aplati, "
+          "et le résultat est celui d'un StaticPerceptron de même forme") {
+    StaticPerceptron<float, identity<float>, true> dynamic_layer(net[0_n].weights(), net[0_n].bias());
+
+    REQUIRE(net.parameters().size() == 3 * 4 + 4 + 4 * 2);
+    REQUIRE(net[0_n].parameters.data() == net.parameters().data());
+    REQUIRE((net[0_n] << input) == (dynamic_layer << input));
+
+    auto workspace = net.make_workspace();
+    REQUIRE(net.propagate(input, workspace) == (net << input));
+  }
+
+  SECTION("La forme d'un FixedPerceptron ne peut pas être changée") {
+    REQUIRE_THROWS_AS(net.resize(1_n, 5), std::invalid_argument);
+  }
+}
+
+TEST_CASE("Net : estimer le coût d'une inférence") {
+  SECTION("Lorsque la forme de toutes les couches est connue à la compilation, "
+          "le coût est 'constexpr'") {
+    using FixedNet = Net<FixedPerceptron<float, identity<float>, 4, 16, true>,
+                         FixedPerceptron<float, identity<float>, 16, 3>>;
+
+    static_assert(FixedNet::flops() == 2 * 4 * 16 + 16 + 2 * 16 * 3);
+    static_assert(FixedNet::parameter_bytes() == (4 * 16 + 16 + 16 * 3) * sizeof(float));
+    static_assert(FixedNet::activation_bytes() == (16 + 3) * sizeof(float));
+    static_assert(working_set_bytes<FixedNet>() <= default_l1_cache_bytes);
+  }
+
+  SECTION("Pour des couches dynamiques, le coût est calculé à l'exécution à "
+          "partir de la forme courante") {
+    auto net = Net<StaticPerceptron<double, identity<double>, true>,
+                   RecurrentPerceptron<double, identity<double>>> {10, 20, 5};
+
+    REQUIRE(net.flops() == 2 * 10 * 20 + 20 + 2 * 5 * (20 + 5));
+    REQUIRE(net.parameter_bytes() == (10 * 20 + 20 + 5 * (20 + 5)) * sizeof(double));
+    REQUIRE(net.activation_bytes() == (20 + 2 * 5) * sizeof(double));
+
+    net.resize(1_n, 200);
+
+    REQUIRE(net.flops() == 2 * 10 * 200 + 200 + 2 * 5 * (200 + 5));
+  }
+
+  SECTION("'fits_in_cache' compare la mémoire parcourue par une inférence à la "
+          "taille d'un cache") {
+    auto small_net = Net<StaticPerceptron<float, identity<float>>> {4, 4};
+    auto large_net = Net<StaticPerceptron<float, identity<float>>> {1024, 1024};
+
+    REQUIRE(l1_cache_bytes() > 0);
+    REQUIRE(fits_in_cache(small_net));
+    REQUIRE(!fits_in_cache(large_net, l2_cache_bytes()));
+  }
+}
@@ -2,6 +2,10 @@
 #include "../net.hpp"
 
 #include <list>
+#include <thread>
+#include <vector>
+
+#include "../static_perceptron.hpp"
 
 using namespace neural;
 
@@ -166,3 +170,214 @@ TEST_CASE("Net : redimensionner le réseau") {
     REQUIRE(net3[4_n].moves_nb == 2);
   }
 }
+
+float identity(float x) { return x; }
+
+TEST_CASE("Net : aplatir les paramètres du réseau dans un tampon contigu") {
+  using Layer = StaticPerceptron<float, identity>;
+  auto net = Net<Layer, Layer> {2, 3, 4};
+  net[0_n].weights().setConstant(1);
+  net[1_n].weights().setConstant(2);
+  net.flatten();
+
+  SECTION("Après 'flatten', les paramètres des couches se suivent dans le tampon "
+          "du réseau et conservent leurs valeurs") {
+    auto parameters = net.parameters();
+
+    REQUIRE(parameters.size() == 2 * 3 + 3 * 4);
+    REQUIRE(net[0_n].parameters.data() == parameters.data());
+    REQUIRE(net[1_n].parameters.data() == parameters.data() + 2 * 3);
+    REQUIRE(std::count(parameters.begin(), parameters.end(), 1) == 2 * 3);
+    REQUIRE(std::count(parameters.begin(), parameters.end(), 2) == 3 * 4);
+    REQUIRE(reinterpret_cast<uintptr_t>(parameters.data()) % 64 == 0);
+  }
+
+  SECTION("Les couches du réseau utilisent le tampon pour stocker leurs poids") {
+    net.parameters()[0] = 5;
+
+    REQUIRE(net[0_n].weights()(0, 0) == 5);
+  }
+
+  SECTION("La copie d'un réseau aplati possède son propre tampon") {
+    auto copy = net;
+    copy.parameters()[0] = 5;
+
+    REQUIRE(copy[0_n].parameters.data() == copy.parameters().data());
+    REQUIRE(copy[1_n].parameters.data() == copy.parameters().data() + 2 * 3);
+    REQUIRE(copy[0_n].weights()(0, 0) == 5);
+    REQUIRE(net[0_n].weights()(0, 0) == 1);
+
+    net = copy;
+
+    REQUIRE(net[0_n].parameters.data() == net.parameters().data());
+    REQUIRE(net[0_n].weights()(0, 0) == 5);
+  }
+
+  SECTION("Un réseau aplati reste aplati après un redimensionnement") {
+    net.resize(1_n, 5);
+
+    REQUIRE(net.parameters().size() == 2 * 5 + 5 * 4);
+    REQUIRE(net[0_n].weights().rows() == 5);
+    REQUIRE(net[1_n].weights().cols() == 5);
+    REQUIRE(net[1_n].parameters.data() == net.parameters().data() + 2 * 5);
+  }
+}
+
+TEST_CASE("Net : ajouter un biais aux couches") {
+  using Layer = StaticPerceptron<float, identity, true>;
+  auto net = Net<Layer, Layer> {2, 3, 1};
+  net.flatten();
+  net[0_n].weights().setConstant(1);
+  net[0_n].bias() << 1, 2, 3;
+  net[1_n].weights().setConstant(1);
+  net[1_n].bias().setConstant(-1);
+
+  SECTION("Le biais de chaque neurone est stocké à la suite de ses poids et fait "
+          "partie des paramètres du réseau") {
+    auto parameters = net.parameters();
+
+    REQUIRE(parameters.size() == (2 + 1) * 3 + (3 + 1) * 1);
+    REQUIRE(net[0_n].bias().data() == parameters.data() + 2);
+    REQUIRE(parameters[2 * 3 + 2] == 3);
+    REQUIRE(net[1_n].parameters.data() == parameters.data() + (2 + 1) * 3);
+  }
+
+  SECTION("'neurons' découpe les paramètres en un bloc contigu par neurone, "
+          "biais compris") {
+    auto neurons = net.neurons();
+
+    REQUIRE(neurons.size() == 3 + 1);
+    REQUIRE(neurons[0].data() == net.parameters().data());
+    REQUIRE(neurons[1].size() == 2 + 1);
+    REQUIRE(neurons[1][2] == 2);
+    REQUIRE(neurons[3].size() == 3 + 1);
+    REQUIRE(neurons[3].data() == net[1_n].parameters.data());
+  }
+
+  SECTION("Le biais est ajouté au produit matrice-vecteur avant la fonction "
+          "d'activation") {
+    Vector<float> input(2);
+    input << 1, 1;
+    Vector<float> hidden(3);
+    hidden << 3, 4, 5;
+
+    REQUIRE((net[0_n] << input) == hidden);
+    REQUIRE((net << input)[0] == 3 + 4 + 5 - 1);
+
+    auto workspace = net.make_workspace();
+    REQUIRE(net.propagate(input, workspace) == (net << input));
+  }
+
+  SECTION("Le biais est appliqué à chaque colonne d'une matrice d'entrées") {
+    Matrix<float> inputs = Matrix<float>::Zero(2, 4);
+    Matrix<float> outputs = net[0_n] << inputs;
+
+    for (int j = 0; j < 4; j++)
+      REQUIRE(outputs.col(j) == net[0_n].bias());
+  }
+}
+
+float relu(float x) { return std::max(x, 0.f); }
+
+TEST_CASE("Net : faire grandir ou rétrécir une intercouche en conservant les poids") {
+  using Layer = StaticPerceptron<float, relu, true>;
+  auto net = Net<Layer, Layer, Layer> {3, 4, 5, 2};
+  net.flatten();
+  for (size_t i = 0; i < net.parameters().size(); i++) net.parameters()[i] = (i % 7) / 3.f - 1;
+  auto original = net;
+  Vector<float> input(3);
+  input << 1, -2, 3;
+
+  SECTION("Après 'grow', les poids existants sont conservés, les nouveaux "
+          "neurones et les poids qui les relient à la couche suivante sont nuls, "
+          "et la sortie du réseau est inchangée") {
+    net.grow(1_n, 2);
+
+    REQUIRE(net[0_n].output_size() == 6);
+    REQUIRE(net[1_n].input_size() == 6);
+    REQUIRE(net.parameters().size() == original.parameters().size() + 2 * (3 + 1) + 2 * 5);
+    REQUIRE(net[0_n].weights().topRows(4) == original[0_n].weights());
+    REQUIRE(net[0_n].weights().bottomRows(2).isZero());
+    REQUIRE(net[0_n].bias().head(4) == original[0_n].bias());
+    REQUIRE(net[1_n].weights().leftCols(4) == original[1_n].weights());
+    REQUIRE(net[1_n].weights().rightCols(2).isZero());
+    REQUIRE(net[1_n].bias() == original[1_n].bias());
+    REQUIRE(net[2_n].weights() == original[2_n].weights());
+    REQUIRE(net[2_n].parameters.data() + net[2_n].parameters.size()
+            == net.parameters().data() + net.parameters().size());
+    REQUIRE((net << input) == (original << input));
+  }
+
+  SECTION("Lorsque la place a été réservée, 'grow' ne réalloue pas le tampon") {
+    net.reserve(net.parameters().size() + 100);
+    auto data = net.parameters().data();
+    net.grow(2_n, 3);
+    net.grow(1_n, 1);
+
+    REQUIRE(net.parameters().data() == data);
+    REQUIRE(net[0_n].parameters.data() == data);
+    REQUIRE((net << input) == (original << input));
+  }
+
+  SECTION("'shrink' retire les derniers neurones : rétrécir après avoir grandi "
+          "redonne le réseau d'origine") {
+    net.grow(1_n, 2);
+    net.shrink(1_n, 2);
+
+    REQUIRE(net.parameters().size() == original.parameters().size());
+    REQUIRE(std::ranges::equal(net.parameters(), original.parameters()));
+    REQUIRE(net[1_n].parameters.data() == net.parameters().data() + 4 * (3 + 1));
+  }
+
+  SECTION("'shrink' conserve les poids des neurones restants") {
+    net.shrink(2_n, 1);
+
+    REQUIRE(net[1_n].output_size() == 4);
+    REQUIRE(net[1_n].weights() == original[1_n].weights().topRows(4));
+    REQUIRE(net[2_n].weights() == original[2_n].weights().leftCols(4));
+    REQUIRE(net[2_n].bias() == original[2_n].bias());
+    REQUIRE_THROWS_AS(net.shrink(2_n, 5), std::invalid_argument);
+  }
+}
+
+float halve(float x) { return x / 2; }
+
+TEST_CASE("Net : calculer la sortie du réseau avec une mémoire de travail") {
+  const auto net = [] {
+    auto net = Net<StaticPerceptron<float, identity>, StaticPerceptron<float, halve>> {4, 8, 2};
+    net.flatten();
+    for (size_t i = 0; i < net.parameters().size(); i++) net.parameters()[i] = i % 7 - 3;
+    return net;
+  }();
+  Vector<float> input(4);
+  input << 1, 2, 3, 4;
+
+  SECTION("La fonction membre const 'propagate' donne le même résultat que "
+          "l'opérateur << et stocke la sortie de chaque couche dans la mémoire "
+          "de travail") {
+    auto workspace = net.make_workspace();
+    const auto& output = net.propagate(input, workspace);
+
+    REQUIRE(output == (net << input));
+    REQUIRE(&output == &std::get<1>(workspace));
+    REQUIRE(std::get<0>(workspace) == (net[0_n] << input));
+  }
+
+  SECTION("Plusieurs threads peuvent utiliser le même réseau en même temps, "
+          "chacun avec sa propre mémoire de travail") {
+    auto expected = net << input;
+    std::vector<int> errors_nb(8, 0);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 8; i++) {
+      threads.emplace_back([&, i] {
+        auto workspace = net.make_workspace();
+        for (int j = 0; j < 1000; j++)
+          errors_nb[i] += net.propagate(input, workspace) != expected;
+      });
+    }
+    for (auto& thread : threads) thread.join();
+
+    REQUIRE(std::count(errors_nb.begin(), errors_nb.end(), 0) == 8);
+  }
+}
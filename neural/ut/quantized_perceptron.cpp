@@ -0,0 +1,100 @@
+#include <catch.hpp>
+#include "../quantized_perceptron.hpp"
+
+#include <cmath>
+#include <random>
+
+#include "../net.hpp"
+#include "../static_perceptron.hpp"
+
+using namespace neural;
+
+float relu(float x) { return std::max(x, 0.f); }
+float sigmoid(float x) { return 1 / (1 + std::exp(-x)); }
+
+TEST_CASE("dot_int8 : calculer le produit scalaire de deux vecteurs d'entiers") {
+  std::mt19937                       rnd_engine(1337);
+  std::uniform_int_distribution<int> pick_value(-128, 127);
+
+  SECTION("Le résultat est identique au produit scalaire naïf, quelle que soit "
+          "la taille des vecteurs") {
+    for (int size : {0, 1, 7, 8, 15, 16, 17, 33, 100}) {
+      std::vector<int8_t> lhs(size), rhs(size);
+      int32_t expected = 0;
+      for (int i = 0; i < size; i++) {
+        lhs[i] = pick_value(rnd_engine);
+        rhs[i] = pick_value(rnd_engine);
+        expected += lhs[i] * rhs[i];
+      }
+
+      REQUIRE(dot_int8(lhs.data(), rhs.data(), size) == expected);
+    }
+  }
+}
+
+TEST_CASE("quantize : convertir un réseau entraîné en réseau quantifié") {
+  std::mt19937                          rnd_engine(1337);
+  std::normal_distribution<float>       make_noise(0, 1);
+  std::uniform_real_distribution<float> pick_angle(-M_PI, M_PI), pick_distance(0, 7);
+
+  auto net = Net<StaticPerceptron<float, relu>, StaticPerceptron<float, sigmoid>> {3, 15, 3};
+  net.for_each([&](auto& layer) {
+    Matrix<float> weights(layer.output_size(), layer.input_size());
+    for (auto& weight : weights.reshaped()) weight = make_noise(rnd_engine);
+    layer.weights() = weights;
+  });
+  auto quantized_net = quantize(net);
+
+  REQUIRE(quantized_net[0_n].input_size() == 3);
+  REQUIRE(quantized_net[0_n].output_size() == 15);
+  REQUIRE(quantized_net[1_n].output_size() == 3);
+
+  SECTION("Sur des entrées semblables à celles d'une épreuve, les sorties du "
+          "réseau quantifié restent proches de celles du réseau d'origine et "
+          "les décisions de rotation sont les mêmes dans la grande majorité "
+          "des cas") {
+    int same_decisions_nb = 0;
+    for (int i = 0; i < 1000; i++) {
+      auto angle = pick_angle(rnd_engine);
+      Vector<float> input(3);
+      input << std::sin(angle), std::cos(angle), pick_distance(rnd_engine);
+
+      Vector<float> output = net << input;
+      Vector<float> quantized_output = quantized_net << input;
+
+      REQUIRE((output - quantized_output).cwiseAbs().maxCoeff() < 0.05);
+      same_decisions_nb += std::signbit(output[2] - output[1])
+                        == std::signbit(quantized_output[2] - quantized_output[1]);
+    }
+
+    CHECK(same_decisions_nb >= 950);
+  }
+
+  SECTION("Une matrice d'entrées est traitée colonne par colonne") {
+    Matrix<float> inputs = Matrix<float>::Random(3, 10);
+    Matrix<float> outputs = quantized_net << inputs;
+
+    for (int j = 0; j < 10; j++)
+      REQUIRE(outputs.col(j) == quantized_net << Vector<float>(inputs.col(j)));
+  }
+}
+
+TEST_CASE("quantize : conserver le biais d'une couche entraînée") {
+  Matrix<float> weights(2, 2);
+  weights << 1, -1,
+             0.5, 2;
+  Vector<float> bias(2);
+  bias << 0.25, -3;
+  auto quantized_layer = quantize(StaticPerceptron<float, relu, true>(weights, bias));
+
+  SECTION("Le biais n'est pas quantifié et il est ajouté avant la fonction "
+          "d'activation") {
+    Vector<float> input(2);
+    input << 1, 1;
+    Vector<float> output(2);
+    output << 0.25, 0;
+
+    REQUIRE(quantized_layer.bias == bias);
+    REQUIRE(((quantized_layer << input) - output).cwiseAbs().maxCoeff() < 0.05);
+  }
+}
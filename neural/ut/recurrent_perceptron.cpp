@@ -0,0 +1,108 @@
+#include <catch.hpp>
+#include "../recurrent_perceptron.hpp"
+
+#include "../net.hpp"
+#include "../static_perceptron.hpp"
+
+using namespace neural;
+
+float identity(float x) { return x; }
+
+TEST_CASE("RecurrentPerceptron : conserver un état caché d'un pas à l'autre") {
+  Matrix<float> weights(2, 1);
+  weights << 1,
+             2;
+  Matrix<float> recurrent_weights(2, 2);
+  recurrent_weights << 1, 0,
+                       0, 0.5;
+  Vector<float> bias(2);
+  bias << 0, 1;
+  RecurrentPerceptron<float, identity, true> layer(weights, recurrent_weights, bias);
+  Vector<float> input(1);
+  input << 1;
+
+  SECTION("Les poids, les poids récurrents et le biais sont stockés à la suite "
+          "dans les paramètres de la couche") {
+    REQUIRE(layer.parameters.size() == 2 * 1 + 2 * 2 + 2);
+    REQUIRE(layer.recurrent_weights().data() == layer.parameters.data() + 2);
+    REQUIRE(layer.bias().data() == layer.parameters.data() + 2 + 4);
+  }
+
+  SECTION("Chaque pas dépend de l'état caché du pas précédent, qui est conservé "
+          "dans la mémoire de travail") {
+    decltype(layer)::Workspace workspace(2);
+    Vector<float> expected(2);
+
+    layer.propagate(input, workspace);
+    expected << 1, 3;
+    REQUIRE(workspace.output == expected);
+
+    layer.propagate(input, workspace);
+    expected << 2, 4.5;
+    REQUIRE(workspace.output == expected);
+  }
+
+  SECTION("Les pas successifs n'allouent pas de mémoire : les deux tampons de la "
+          "mémoire de travail sont échangés") {
+    decltype(layer)::Workspace workspace(2);
+    auto first = workspace.output.data(), second = workspace.previous.data();
+
+    for (int i = 0; i < 3; i++) {
+      layer.propagate(input, workspace);
+      REQUIRE(((workspace.output.data() == first && workspace.previous.data() == second)
+            || (workspace.output.data() == second && workspace.previous.data() == first)));
+    }
+  }
+
+  SECTION("Appliquée à une matrice, la couche traite les colonnes comme une "
+          "séquence temporelle") {
+    Matrix<float> inputs = Matrix<float>::Ones(1, 2);
+    Matrix<float> expected(2, 2);
+    expected << 1, 2,
+                3, 4.5;
+
+    REQUIRE((layer << inputs) == expected);
+  }
+}
+
+TEST_CASE("RecurrentPerceptron : utiliser une couche récurrente dans un Net") {
+  auto net = Net<RecurrentPerceptron<float, identity, true>, StaticPerceptron<float, identity>> {3, 4, 2};
+  net.flatten();
+  for (size_t i = 0; i < net.parameters().size(); i++) net.parameters()[i] = (i % 5) / 4.f - 0.5f;
+  Vector<float> input(3);
+  input << 1, 2, 3;
+
+  SECTION("Les poids récurrents font partie des paramètres du réseau aplati") {
+    REQUIRE(net.parameters().size() == 4 * (3 + 4) + 4 + 2 * 4);
+    REQUIRE(net[0_n].parameters.data() == net.parameters().data());
+    REQUIRE(net[1_n].parameters.data() == net.parameters().data() + 4 * (3 + 4) + 4);
+  }
+
+  SECTION("'propagate' fait avancer l'état caché et 'reset' le remet à zéro sans "
+          "changer la mémoire de travail") {
+    auto workspace = net.make_workspace();
+    Vector<float> first_output = net.propagate(input, workspace);
+    Vector<float> second_output = net.propagate(input, workspace);
+
+    REQUIRE(first_output == (net << input));
+    REQUIRE(second_output != first_output);
+
+    auto state = std::get<0>(workspace).output.data();
+    decltype(net)::reset(workspace);
+
+    REQUIRE(net.propagate(input, workspace) == first_output);
+    REQUIRE((std::get<0>(workspace).output.data() == state
+          || std::get<0>(workspace).previous.data() == state));
+  }
+
+  SECTION("Appliqué à une matrice, le réseau donne la sortie de chaque pas de la "
+          "séquence") {
+    Matrix<float> inputs(3, 2);
+    inputs << input, input;
+    auto workspace = net.make_workspace();
+    Matrix<float> outputs = net << inputs;
+
+    REQUIRE(outputs.col(0) == net.propagate(input, workspace));
+    REQUIRE(outputs.col(1) == net.propagate(input, workspace));
+  }
+}
@@ -0,0 +1,176 @@
+#include <catch.hpp>
+#include "../serialization.hpp"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "../conv1d.hpp"
+#include "../net.hpp"
+#include "../recurrent_perceptron.hpp"
+#include "../static_perceptron.hpp"
+
+using namespace neural;
+
+double identity(double x) { return x; }
+double twice(double x) { return 2 * x; }
+
+template<>
+struct neural::ActivationId<identity> { static constexpr uint32_t value = 256; };
+
+template<>
+struct neural::ActivationId<twice> { static constexpr uint32_t value = 257; };
+
+using TestNet = Net<StaticPerceptron<double, identity>, StaticPerceptron<double, twice>>;
+
+// Vérifier qu'un fichier corrompu est rejeté par 'load' comme par 'map_net'
+void require_rejected(const std::string& content) {
+  std::stringstream corrupted(content);
+  REQUIRE_THROWS_AS(load<TestNet>(corrupted), std::runtime_error);
+
+  auto path = std::filesystem::temp_directory_path() / "ut_serialization_corrupted.nn";
+  std::ofstream(path, std::ios::binary) << content;
+  MappedFile file(path);
+  REQUIRE_THROWS_AS(map_net<TestNet>(file), std::runtime_error);
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("save / load : sauvegarder et recharger un réseau") {
+  auto net = TestNet {3, 5, 2};
+  net.flatten();
+  for (size_t i = 0; i < net.parameters().size(); i++) net.parameters()[i] = 0.5 * i;
+
+  Vector<double> input(3);
+  input << 1, -2, 3;
+
+  SECTION("Un réseau rechargé depuis un flux a les mêmes paramètres et donne "
+          "les mêmes sorties que le réseau sauvegardé") {
+    std::stringstream stream;
+    save(net, stream);
+    auto loaded_net = load<TestNet>(stream);
+
+    REQUIRE(std::ranges::equal(loaded_net.parameters(), net.parameters()));
+    REQUIRE((loaded_net << input) == (net << input));
+  }
+
+  SECTION("Les blocs de paramètres sont alignés sur 64 octets dans le fichier") {
+    std::stringstream stream;
+    save(net, stream);
+    auto content = stream.str();
+
+    LayerHeader layer_headers[2];
+    std::copy_n(content.data() + sizeof(FileHeader), sizeof(layer_headers),
+                reinterpret_cast<char*>(layer_headers));
+
+    REQUIRE(layer_headers[0].offset % 64 == 0);
+    REQUIRE(layer_headers[1].offset % 64 == 0);
+    REQUIRE(layer_headers[1].offset >= layer_headers[0].offset + 3 * 5 * sizeof(double));
+  }
+
+  SECTION("L'identifiant d'une couche ne dépend que de son type, de ses options "
+          "et de sa fonction d'activation") {
+    std::stringstream stream;
+    save(net, stream);
+    auto content = stream.str();
+
+    LayerHeader layer_headers[2];
+    std::copy_n(content.data() + sizeof(FileHeader), sizeof(layer_headers),
+                reinterpret_cast<char*>(layer_headers));
+
+    REQUIRE(layer_headers[0].type_id == 0x01000100);
+    REQUIRE(layer_headers[1].type_id == 0x01000101);
+    REQUIRE(LayerId<StaticPerceptron<float, sigmoid<float>, true>>::value == 0x01010002);
+  }
+
+  SECTION("Charger un fichier qui ne correspond pas au type du réseau lève une "
+          "exception") {
+    using OtherNet = Net<StaticPerceptron<double, twice>, StaticPerceptron<double, twice>>;
+    std::stringstream stream;
+    save(net, stream);
+
+    REQUIRE_THROWS(load<OtherNet>(stream));
+
+    std::stringstream garbage("Ceci n'est pas un réseau");
+    REQUIRE_THROWS(load<TestNet>(garbage));
+  }
+
+  SECTION("Un en-tête annonçant un nombre de couches aberrant est rejeté avant "
+          "toute allocation") {
+    std::stringstream stream;
+    save(net, stream);
+    auto content = stream.str();
+    FileHeader file_header;
+    std::copy_n(content.data(), sizeof(FileHeader), reinterpret_cast<char*>(&file_header));
+    file_header.layers_nb = 0xFFFFFFFF;
+    std::copy_n(reinterpret_cast<const char*>(&file_header), sizeof(FileHeader), content.data());
+
+    require_rejected(content);
+  }
+
+  SECTION("Un en-tête de couche annonçant une taille aberrante ou un bloc qui "
+          "dépasse du fichier est rejeté avant toute allocation") {
+    std::stringstream stream;
+    save(net, stream);
+    auto content = stream.str();
+    auto corrupt_layer_header = [&](auto corrupt) {
+      auto corrupted = content;
+      LayerHeader layer_header;
+      auto position = corrupted.data() + sizeof(FileHeader) + sizeof(LayerHeader);
+      std::copy_n(position, sizeof(LayerHeader), reinterpret_cast<char*>(&layer_header));
+      corrupt(layer_header);
+      std::copy_n(reinterpret_cast<const char*>(&layer_header), sizeof(LayerHeader), position);
+      return corrupted;
+    };
+
+    require_rejected(corrupt_layer_header([](auto& header) { header.output_size = uint64_t(1) << 40; }));
+    require_rejected(corrupt_layer_header([](auto& header) {
+      header.output_size = uint64_t(1) << 20;
+      header.parameters_nb = header.output_size * 5;
+    }));
+    require_rejected(corrupt_layer_header([](auto& header) { header.offset = 0; }));
+    require_rejected(corrupt_layer_header([](auto& header) { header.offset = uint64_t(1) << 62; }));
+    require_rejected(content.substr(0, content.size() - 1));
+  }
+
+  SECTION("Un réseau projeté en mémoire utilise directement les paramètres du "
+          "fichier, sans les copier") {
+    auto path = std::filesystem::temp_directory_path() / "ut_serialization.nn";
+    save(net, path);
+
+    MappedFile file(path);
+    auto mapped_net = map_net<TestNet>(file);
+    auto first_block = reinterpret_cast<const std::byte*>(mapped_net[0_n].parameters.data());
+    auto second_block = reinterpret_cast<const std::byte*>(mapped_net[1_n].parameters.data());
+
+    REQUIRE(first_block >= file.data());
+    REQUIRE(second_block < file.data() + file.size());
+    REQUIRE(reinterpret_cast<uintptr_t>(first_block) % 64 == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(second_block) % 64 == 0);
+    REQUIRE((mapped_net << input) == (net << input));
+
+    std::filesystem::remove(path);
+  }
+}
+
+TEST_CASE("map_net : projeter un réseau dont les couches ne sont pas des perceptrons") {
+  using OtherNet = Net<Conv1D<double, identity, 3, true>, RecurrentPerceptron<double, twice, true>>;
+  auto net = OtherNet {8, 16, 4};
+  net.flatten();
+  for (size_t i = 0; i < net.parameters().size(); i++) net.parameters()[i] = 0.01 * i;
+
+  auto path = std::filesystem::temp_directory_path() / "ut_serialization_other.nn";
+  save(net, path);
+  MappedFile file(path);
+  auto mapped_net = map_net<OtherNet>(file);
+
+  Vector<double> input = Vector<double>::LinSpaced(8, -1, 1);
+  REQUIRE(mapped_net[0_n].parameters.is_mapped());
+  REQUIRE(mapped_net[1_n].parameters.is_mapped());
+  REQUIRE((mapped_net << input) == (net << input));
+  REQUIRE(std::ranges::equal(load<OtherNet>(path)[1_n].parameters.view(), net[1_n].parameters.view()));
+
+  std::filesystem::remove(path);
+}
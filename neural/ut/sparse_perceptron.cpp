@@ -0,0 +1,76 @@
+#include <catch.hpp>
+#include "../sparse_perceptron.hpp"
+
+#include <random>
+
+#include "../net.hpp"
+#include "../static_perceptron.hpp"
+
+using namespace neural;
+
+float relu(float x) { return std::max(x, 0.f); }
+float identity(float x) { return x; }
+
+TEST_CASE("prune : convertir une couche dense en couche creuse") {
+  std::mt19937                    rnd_engine(1337);
+  std::normal_distribution<float> make_noise(0, 1);
+
+  StaticPerceptron<float, relu, true> layer(20, 10);
+  for (auto& parameter : layer.parameters.view()) parameter = make_noise(rnd_engine);
+  Vector<float> input = Vector<float>::Random(20);
+
+  SECTION("Avec un seuil nul, la couche creuse calcule la même image que la "
+          "couche dense") {
+    auto sparse_layer = prune(layer, 0.f);
+
+    REQUIRE(sparse_layer.nonzeros_nb() == 20 * 10);
+    REQUIRE(sparse_layer.bias == layer.bias());
+    REQUIRE(((sparse_layer << input) - (layer << input)).cwiseAbs().maxCoeff() < 1e-5);
+  }
+
+  SECTION("Les poids dont l'amplitude ne dépasse pas le seuil sont supprimés, "
+          "et 'sparsity' donne la proportion de poids supprimés") {
+    auto sparse_layer = prune(layer, 1.f);
+    auto removed_nb = (layer.weights().array().abs() <= 1).count();
+
+    REQUIRE(sparse_layer.nonzeros_nb() == 20 * 10 - removed_nb);
+    REQUIRE(sparsity(layer, 1.f) == Approx(double(removed_nb) / (20 * 10)));
+
+    Matrix<float> pruned_weights = sparse_layer.weights;
+    for (Eigen::Index i = 0; i < 10; i++)
+      for (Eigen::Index j = 0; j < 20; j++)
+        REQUIRE(pruned_weights(i, j) == (std::abs(layer.weights()(i, j)) > 1 ? layer.weights()(i, j) : 0));
+  }
+
+  SECTION("'propagate' et l'opérateur << donnent le même résultat, y compris "
+          "pour une matrice d'entrées traitée colonne par colonne") {
+    auto          sparse_layer = prune(layer, 0.5f);
+    Vector<float> output(10);
+    sparse_layer.propagate(input, output);
+
+    REQUIRE(output == (sparse_layer << input));
+
+    Matrix<float> inputs = Matrix<float>::Random(20, 5);
+    Matrix<float> outputs = sparse_layer << inputs;
+    for (int j = 0; j < 5; j++)
+      REQUIRE((outputs.col(j) - (sparse_layer << Vector<float>(inputs.col(j)))).cwiseAbs().maxCoeff() < 1e-5);
+  }
+}
+
+TEST_CASE("prune : élaguer toutes les couches d'un réseau") {
+  auto net = Net<StaticPerceptron<float, identity>, StaticPerceptron<float, identity>> {4, 8, 2};
+  net.flatten();
+  for (size_t i = 0; i < net.parameters().size(); i++) net.parameters()[i] = i % 3 == 0 ? 0.01f : 1.f;
+  auto sparse_net = prune(net, 0.1);
+
+  SECTION("Le réseau élagué conserve la forme du réseau d'origine et ne garde "
+          "que les poids de grande amplitude") {
+    Vector<float> input = Vector<float>::Random(4);
+
+    REQUIRE(sparse_net[0_n].input_size() == 4);
+    REQUIRE(sparse_net[1_n].output_size() == 2);
+    REQUIRE(sparse_net[0_n].nonzeros_nb() + sparse_net[1_n].nonzeros_nb()
+            == std::count(net.parameters().begin(), net.parameters().end(), 1.f));
+    REQUIRE(((sparse_net << input) - (prune(net, 0.f) << input)).cwiseAbs().maxCoeff() < 0.1);
+  }
+}
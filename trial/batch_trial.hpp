@@ -0,0 +1,259 @@
+#pragma once
+
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <vector>
+
+#include <eigen3/Eigen/Core>
+
+#include <units/random.h>
+
+#include "component.hpp"
+#include "outcome.hpp"
+#include "physics.hpp"
+#include "position_picker.hpp"
+#include "trial_parameters.hpp"
+#include "trial_results.hpp"
+
+/*******************************************************************************
+  BatchTrial fait avancer en même temps plusieurs épreuves indépendantes, qui
+  partagent les mêmes paramètres mais pas la même graine. Les règles sont celles
+  de 'perform_trial' (voir 'mechanic.hpp') : mêmes positions de départ pour une
+  graine donnée, même cinématique, mêmes conditions de fin.
+
+  L'état n'est pas stocké dans un registre mais en structure de tableaux : un
+  tableau par grandeur, avec une ligne par épreuve et une colonne par robot (le
+  candidat est le robot 0). Les tableaux étant stockés par colonne, un même
+  robot de toutes les épreuves est contigu en mémoire, et la cinématique, les
+  objectifs et les collisions sont calculés par des expressions Eigen sur tous
+  les robots à la fois, vectorisées (y compris 'cos' et 'sin'). Une épreuve
+  terminée est masquée : son pas de temps devient nul et ses robots ne sont plus
+  pilotés.
+
+  Les stratégies ne reçoivent pas de registre : ce sont des foncteurs de
+  signature 'Setpoint(const BatchTrial&, size_t trial, size_t robot)' qui lisent
+  l'état des robots par les accesseurs de BatchTrial. Le candidat peut dépendre
+  de l'épreuve, par exemple pour évaluer plusieurs individus en même temps.
+*******************************************************************************/
+
+class BatchTrial;
+
+template<typename T>
+concept BatchStrategy = std::invocable<T, const BatchTrial&, size_t, size_t>;
+
+class BatchTrial {
+public:
+  using numeric = physics::numeric;
+  using Lanes = Eigen::Array<numeric, Eigen::Dynamic, Eigen::Dynamic>;
+  using Column = Eigen::Array<numeric, Eigen::Dynamic, 1>;
+  using Mask = Eigen::Array<bool, Eigen::Dynamic, Eigen::Dynamic>;
+  using ColumnMask = Eigen::Array<bool, Eigen::Dynamic, 1>;
+
+  // Préparer une épreuve par graine. Le champ 'seed' de 'trial_parameters' est
+  // ignoré.
+  BatchTrial(const TrialParameters& trial_parameters, std::span<const int64_t> seeds,
+             const Hitbox& candidate_hitbox, const Hitbox& foe_hitbox)
+    : parameters(trial_parameters),
+      trials_nb(seeds.size()),
+      robots_nb(trial_parameters.foe_nb + 1),
+      x(trials_nb, robots_nb), y(trials_nb, robots_nb),
+      start_x(trials_nb, robots_nb), start_y(trials_nb, robots_nb),
+      direction(trials_nb, robots_nb),
+      speed(Lanes::Zero(trials_nb, robots_nb)),
+      angular_speed(Lanes::Zero(trials_nb, robots_nb)),
+      goal_x(trials_nb, robots_nb), goal_y(trials_nb, robots_nb),
+      radius(robots_nb),
+      time(Column::Zero(trials_nb)),
+      best_distance(trials_nb),
+      step(Column::Constant(trials_nb, trial_parameters.dt.count())),
+      outcomes(trials_nb, Outcome::none)
+  {
+    using units::uniform_real_distribution;
+
+    radius.setConstant(foe_hitbox.radius.count());
+    radius[0] = candidate_hitbox.radius.count();
+
+    // Tirer les positions dans le même ordre que 'create_robot'
+    PositionPicker pick_position(parameters.playground);
+    uniform_real_distribution<physics::angle> pick_angle(0_q_rad, 2 * physics::pi);
+    rnd_engines.reserve(trials_nb);
+    for (size_t trial = 0; trial < trials_nb; trial++) {
+      auto& rnd_engine = rnd_engines.emplace_back(seeds[trial]);
+      for (size_t robot = 0; robot < robots_nb; robot++) {
+        auto position = pick_position(rnd_engine);
+        x(trial, robot) = position.x.count();
+        y(trial, robot) = position.y.count();
+        direction(trial, robot) = pick_angle(rnd_engine).count();
+        auto goal = pick_position(rnd_engine);
+        goal_x(trial, robot) = goal.x.count();
+        goal_y(trial, robot) = goal.y.count();
+      }
+    }
+
+    best_distance = distances_to_goal(0);
+    update_activity();
+  }
+
+  // Mener toutes les épreuves à leur terme
+  std::vector<TrialResults> run(BatchStrategy auto&& candidate_strategy,
+                                BatchStrategy auto&& foe_strategy) {
+    while (is_running()) update(candidate_strategy, foe_strategy);
+    return results();
+  }
+
+  // Faire avancer d'un pas de temps toutes les épreuves qui ne sont pas terminées
+  void update(BatchStrategy auto&& candidate_strategy, BatchStrategy auto&& foe_strategy) {
+    set_setpoints(candidate_strategy, foe_strategy);
+    update_positions();
+    update_tasks();
+    detect_collisions();
+
+    best_distance = (step > 0).select(best_distance.min(distances_to_goal(0)), best_distance);
+    time += step;
+    update_activity();
+  }
+
+  //
+  bool is_running() const {
+    return (step > 0).any();
+  }
+
+  //
+  std::vector<TrialResults> results() const {
+    std::vector<TrialResults> results;
+    results.reserve(trials_nb);
+    for (size_t trial = 0; trial < trials_nb; trial++)
+      results.push_back({
+        .outcome = outcomes[trial],
+        .time = physics::time(time[trial]),
+        .best_distance = physics::length(best_distance[trial])
+      });
+    return results;
+  }
+
+  // Accéder à l'état d'un robot d'une épreuve, par exemple depuis une stratégie
+  Position position(size_t trial, size_t robot) const {
+    return {physics::length(x(trial, robot)), physics::length(y(trial, robot))};
+  }
+  Position goal(size_t trial, size_t robot) const {
+    return {physics::length(goal_x(trial, robot)), physics::length(goal_y(trial, robot))};
+  }
+  physics::angle get_direction(size_t trial, size_t robot) const {
+    return physics::angle(direction(trial, robot));
+  }
+  physics::speed get_speed(size_t trial, size_t robot) const {
+    return physics::speed(speed(trial, robot));
+  }
+
+  //
+  size_t get_trials_nb() const { return trials_nb; }
+  size_t get_robots_nb() const { return robots_nb; }
+
+private:
+  // Seuls les robots des épreuves en cours sont pilotés
+  void set_setpoints(auto&& candidate_strategy, auto&& foe_strategy) {
+    for (size_t trial = 0; trial < trials_nb; trial++) {
+      if (step[trial] == 0) continue;
+      for (size_t robot = 0; robot < robots_nb; robot++) {
+        Setpoint setpoint = robot == 0 ?
+          candidate_strategy(*this, trial, robot)
+        : foe_strategy(*this, trial, robot);
+        speed(trial, robot) = setpoint.speed.count();
+        angular_speed(trial, robot) = setpoint.angular_speed.count();
+      }
+    }
+  }
+
+  // Même calcul que la fonction libre 'update_positions', sur toutes les
+  // épreuves à la fois. Le pas de temps d'une épreuve terminée est nul.
+  void update_positions() {
+    const auto& playground = parameters.playground;
+    auto left = playground.left.count(), right = left + playground.width.count();
+    auto top = playground.top.count(), bottom = top + playground.height.count();
+    auto row_radius = radius.transpose().replicate(trials_nb, 1);
+
+    start_x = x;
+    start_y = y;
+    Lanes distance = speed.colwise() * step;
+    x = (x + distance * direction.cos()).max(left + row_radius).min(right - row_radius);
+    y = (y + distance * direction.sin()).max(top + row_radius).min(bottom - row_radius);
+
+    // Equivalent de 'fmod(direction, 2 * pi)' : le quotient est tronqué vers zéro
+    constexpr numeric two_pi = 2 * M_PI;
+    direction += angular_speed.colwise() * step;
+    Lanes turns = direction / two_pi;
+    direction -= two_pi * (turns >= 0).select(turns.floor(), turns.ceil());
+  }
+
+  // Un robot qui atteint son objectif en reçoit un nouveau, tiré avec le
+  // générateur de son épreuve ; l'épreuve est réussie si c'est le candidat
+  void update_tasks() {
+    constexpr numeric reach = 0.05; // Voir 'Task::update'
+    Mask reached = ((x - goal_x).square() + (y - goal_y).square() < reach * reach)
+                && (step > 0).replicate(1, robots_nb);
+    if (!reached.any()) return;
+
+    PositionPicker pick_position(parameters.playground);
+    for (size_t robot = 0; robot < robots_nb; robot++) {
+      for (size_t trial = 0; trial < trials_nb; trial++) {
+        if (!reached(trial, robot)) continue;
+        auto goal = pick_position(rnd_engines[trial]);
+        goal_x(trial, robot) = goal.x.count();
+        goal_y(trial, robot) = goal.y.count();
+        if (robot == 0) outcomes[trial] = Outcome::goal_reached;
+      }
+    }
+  }
+
+  // Comme 'detect_collisions', seules les collisions avec le candidat comptent,
+  // à un instant quelconque du pas (même test que 'Hitbox::get_impact_fraction')
+  void detect_collisions() {
+    ColumnMask collided = ColumnMask::Constant(trials_nb, false);
+    for (size_t robot = 1; robot < robots_nb; robot++) {
+      auto   contact = radius[0] + radius[robot];
+      Column start_dx = start_x.col(robot) - start_x.col(0);
+      Column start_dy = start_y.col(robot) - start_y.col(0);
+      Column dx = x.col(robot) - x.col(0) - start_dx, dy = y.col(robot) - y.col(0) - start_dy;
+      Column a = dx.square() + dy.square(), b = 2 * (start_dx * dx + start_dy * dy);
+      Column c = start_dx.square() + start_dy.square() - contact * contact;
+      Column discriminant = b.square() - 4 * a * c;
+      collided = collided || c < 0
+              || (b < 0 && discriminant >= 0 && -b - discriminant.max(0).sqrt() <= 2 * a);
+    }
+
+    for (size_t trial = 0; trial < trials_nb; trial++)
+      if (collided[trial] && step[trial] > 0 && outcomes[trial] != Outcome::candidate_collided)
+        outcomes[trial] = speed(trial, 0) != 0 ?
+          Outcome::candidate_collided
+        : Outcome::foe_collided;
+  }
+
+  //
+  Column distances_to_goal(size_t robot) const {
+    return ((x.col(robot) - goal_x.col(robot)).square()
+          + (y.col(robot) - goal_y.col(robot)).square()).sqrt();
+  }
+
+  // Masquer les épreuves terminées
+  void update_activity() {
+    for (size_t trial = 0; trial < trials_nb; trial++)
+      if (outcomes[trial] != Outcome::none || time[trial] >= parameters.time_limit.count())
+        step[trial] = 0;
+  }
+
+  TrialParameters parameters;
+  size_t          trials_nb;
+  size_t          robots_nb;
+
+  Lanes x, y, start_x, start_y, direction, speed, angular_speed, goal_x, goal_y;
+  Column radius;
+
+  Column                    time;
+  Column                    best_distance;
+  Column                    step;
+  std::vector<Outcome>      outcomes;
+  std::vector<std::mt19937> rnd_engines;
+};
@@ -0,0 +1,103 @@
+#include "../batch_trial.hpp"
+
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "../../benchmark.hpp"
+#include "../trial.hpp"
+
+/*******************************************************************************
+  Comparer le coût d'un pas de robot ('robot-tick') selon que les épreuves sont
+  menées une par une par 'perform_trial' ou toutes ensemble par BatchTrial. Le
+  candidat cherche son objectif et les adversaires tournent en rond, de sorte
+  que la plupart des épreuves durent jusqu'à la limite de temps. Le paramètre
+  est le nombre d'épreuves ; le résultat est la durée d'un robot-tick en
+  nanosecondes. La mesure 'perform_trial<new registry>' construit un registre
+  par épreuve, comme avant l'introduction de TrialContext. A compiler avec
+  GATE_HEADLESS (voir la cible 'bbatch').
+*******************************************************************************/
+
+Setpoint steer(Position translation, physics::angle direction) {
+  auto delta = sin(atan(translation) - direction);
+  return {
+    .speed = 5_q_m_per_s / (1 + 10 * std::abs(delta)),
+    .angular_speed = std::signbit(delta) ? -2_q_rad_per_s : +2_q_rad_per_s
+  };
+}
+
+Setpoint seek_goal(entt::entity entity, entt::registry& registry) {
+  return steer(get_goal(entity, registry) - registry.get<Position>(entity),
+               registry.get<Kinematics>(entity).direction);
+}
+
+Setpoint batch_seek_goal(const BatchTrial& batch, size_t trial, size_t robot) {
+  return steer(batch.goal(trial, robot) - batch.position(trial, robot),
+               batch.get_direction(trial, robot));
+}
+
+Setpoint run_circles(entt::entity, entt::registry&) {
+  return { .speed = 1_q_m_per_s, .angular_speed = 0.5_q_rad_per_s };
+}
+
+Setpoint batch_run_circles(const BatchTrial&, size_t, size_t) {
+  return { .speed = 1_q_m_per_s, .angular_speed = 0.5_q_rad_per_s };
+}
+
+int main(int argc, char** argv) {
+  auto format = bench::parse_format(argc, argv);
+
+  RobotFeatures worker_features { .hitbox {10_q_cm}, .strategy_ftor = seek_goal };
+  RobotFeatures racer_features { .hitbox {10_q_cm}, .strategy_ftor = run_circles };
+
+  for (size_t foe_nb : {0, 8}) {
+    TrialParameters parameters {
+      .playground {0_q_m, 0_q_m, 20_q_m, 20_q_m},
+      .foe_nb = foe_nb,
+      .seed = 0,
+      .dt = 0.1_q_s,
+      .time_limit = 10_q_s
+    };
+    auto suffix = "<" + std::to_string(foe_nb) + " foes>";
+
+    for (size_t trials_nb : {1, 16, 256, 4096}) {
+      std::vector<int64_t> seeds(trials_nb);
+      std::iota(seeds.begin(), seeds.end(), 0);
+
+      // Compter les robot-ticks effectivement simulés
+      double robot_ticks = 0;
+      for (auto seed : seeds) {
+        parameters.seed = seed;
+        robot_ticks += (foe_nb + 1) * (perform_trial(parameters, worker_features, racer_features).time
+                                       / parameters.dt).count();
+      }
+
+      auto iterations_nb = std::max<size_t>(1, 256 / trials_nb);
+      auto unpooled = bench::measure([&] {
+        for (auto seed : seeds) {
+          parameters.seed = seed;
+          TrialContext trial_context;
+          bench::keep(perform_trial(trial_context, parameters, worker_features, racer_features));
+        }
+      }, iterations_nb, 5);
+      auto sequential = bench::measure([&] {
+        for (auto seed : seeds) {
+          parameters.seed = seed;
+          bench::keep(perform_trial(parameters, worker_features, racer_features));
+        }
+      }, iterations_nb, 5);
+      auto batched = bench::measure([&] {
+        BatchTrial batch(parameters, seeds, worker_features.hitbox, racer_features.hitbox);
+        bench::keep(batch.run(batch_seek_goal, batch_run_circles));
+      }, iterations_nb, 5);
+
+      bench::report(std::cout, format, "perform_trial<new registry>" + suffix, trials_nb,
+                    unpooled / robot_ticks);
+      bench::report(std::cout, format, "perform_trial" + suffix, trials_nb, sequential / robot_ticks);
+      bench::report(std::cout, format, "BatchTrial" + suffix, trials_nb, batched / robot_ticks);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,93 @@
+#include "../broad_phase.hpp"
+
+#include <cmath>
+#include <iostream>
+#include <iterator>
+
+#include "../../benchmark.hpp"
+#include "../trial.hpp"
+
+/*******************************************************************************
+  Mesurer le coût par robot de la recherche de tous les contacts entre robots
+  dans une arène dense, dont la surface croît avec le nombre de robots (environ
+  un robot par mètre carré) : par la grille, par balayage ('sweep and prune')
+  ou en testant toutes les paires. Les robots se déplacent d'un pas à chaque
+  mesure, et la mise à jour de la grille ou des intervalles du balayage est
+  comprise dans la mesure. Le paramètre est le nombre de robots ; le résultat
+  est la durée par robot, en nanosecondes. A compiler avec GATE_HEADLESS (voir
+  la cible 'bbroad').
+*******************************************************************************/
+
+Setpoint run_circles(entt::entity, entt::registry&) {
+  return { .speed = 1_q_m_per_s, .angular_speed = 0.5_q_rad_per_s };
+}
+
+// Compter les contacts en testant toutes les paires de robots
+size_t count_all_contacts(entt::registry& registry) {
+  auto   group = bodies(registry);
+  size_t contacts_nb = 0;
+  for (auto lhs = group.begin(); lhs != group.end(); ++lhs)
+    for (auto rhs = std::next(lhs); rhs != group.end(); ++rhs)
+      contacts_nb += group.get<Hitbox>(*lhs).is_intersecting(group.get<Hitbox>(*rhs),
+                       group.get<Position>(*rhs) - group.get<Position>(*lhs));
+  return contacts_nb;
+}
+
+// Compter les contacts en ne testant que les robots voisins dans la grille
+size_t count_near_contacts(const BroadPhase& broad_phase, entt::registry& registry) {
+  size_t contacts_nb = 0;
+  for (auto&& [entity, position, kinematics, hitbox] : bodies(registry).each())
+    broad_phase.for_each_near(position, hitbox.radius + broad_phase.get_max_radius(),
+      [&](const BroadPhase::Body& body) {
+        contacts_nb += body.entity < entity
+                    && body.hitbox.is_intersecting(hitbox, body.position - position);
+      });
+  return contacts_nb;
+}
+
+int main(int argc, char** argv) {
+  auto format = bench::parse_format(argc, argv);
+
+  RobotFeatures racer_features { .hitbox {10_q_cm}, .strategy_ftor = run_circles };
+
+  for (size_t robots_nb : {10, 100, 1000, 10000}) {
+    auto side = physics::length(std::sqrt(physics::numeric(robots_nb)));
+    TrialParameters parameters {
+      .playground {0_q_m, 0_q_m, side, side},
+      .foe_nb = robots_nb - 1,
+      .seed = 0,
+      .dt = 0.1_q_s,
+      .time_limit = 10_q_s
+    };
+    TrialContext trial_context;
+    populate_trial(trial_context, parameters, racer_features, racer_features, false);
+    auto& registry = trial_context.get_registry();
+    const auto& broad_phase = registry.ctx_or_set<BroadPhase>();
+
+    auto iterations_nb = std::max<size_t>(10, 1e5 / robots_nb);
+    auto near_pairs = bench::measure([&] {
+      update_positions(registry);
+      update_broad_phase(registry);
+      bench::keep(count_near_contacts(broad_phase, registry));
+    }, iterations_nb);
+    auto swept_pairs = bench::measure([&] {
+      update_positions(registry);
+      update_contacts(registry);
+      bench::keep(registry.ctx<SweepAndPrune>().get_contacts().size());
+    }, iterations_nb);
+
+    bench::report(std::cout, format, "all pairs<grid>", robots_nb, near_pairs / robots_nb);
+    bench::report(std::cout, format, "all pairs<sweep and prune>", robots_nb, swept_pairs / robots_nb);
+
+    // Le test de toutes les paires est quadratique : il n'est mesuré que
+    // jusqu'à 1000 robots
+    if (robots_nb <= 1000) {
+      auto all_pairs = bench::measure([&] {
+        bench::keep(count_all_contacts(registry));
+      }, std::max<size_t>(1, iterations_nb / robots_nb));
+      bench::report(std::cout, format, "all pairs<brute force>", robots_nb, all_pairs / robots_nb);
+    }
+  }
+
+  return 0;
+}
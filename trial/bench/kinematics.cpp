@@ -0,0 +1,119 @@
+#include "../mechanic.hpp"
+
+#include <iostream>
+#include <string>
+
+#include "../../benchmark.hpp"
+#include "../trial.hpp"
+
+/*******************************************************************************
+  Mesurer le coût par robot des systèmes physiques selon la disposition des
+  composants : 'Kinematics' dans le groupe 'bodies' (disposition actuelle), ou
+  direction, vitesse et vitesse angulaire dans trois stockages séparés, parcourus
+  par une vue (disposition antérieure). Le paramètre est le nombre de robots ;
+  le résultat est la durée d'un pas par robot, en nanosecondes. La recherche
+  des contacts ('update_contacts'), que lit 'detect_collisions', est comprise
+  dans sa mesure. A compiler avec GATE_HEADLESS (voir la cible 'bkinematics').
+*******************************************************************************/
+
+Setpoint run_circles(entt::entity, entt::registry&) {
+  return { .speed = 1_q_m_per_s, .angular_speed = 0.5_q_rad_per_s };
+}
+
+// Copier l'état des robots d'une épreuve dans des composants séparés
+void make_legacy_layout(const entt::registry& registry, entt::registry& legacy) {
+  legacy.ctx_or_set<TrialParameters>(registry.ctx<TrialParameters>());
+  legacy.ctx_or_set<Outcome>(Outcome::none);
+  for (auto&& [entity, position, kinematics, hitbox] : registry.view<const Position, const Kinematics, const Hitbox>().each()) {
+    auto copy = legacy.create();
+    legacy.emplace<Position>(copy, position);
+    legacy.emplace<physics::speed>(copy, kinematics.speed);
+    legacy.emplace<physics::angular_speed>(copy, kinematics.angular_speed);
+    legacy.emplace<physics::angle>(copy, kinematics.direction);
+    legacy.emplace<Hitbox>(copy, hitbox);
+    if (entity == registry.ctx<entt::entity>()) legacy.ctx_or_set<entt::entity>(copy);
+  }
+}
+
+// 'update_positions' tel qu'il était écrit avant l'introduction de 'Kinematics'
+void legacy_update_positions(entt::registry& registry) {
+  auto bodies = registry.view<Position, Hitbox, physics::angle, physics::speed, physics::angular_speed>();
+  const auto& playground = registry.ctx<TrialParameters>().playground;
+  auto dt = registry.ctx<TrialParameters>().dt;
+  for (auto&& [entity, position, hitbox, direction, speed, angular_speed] : bodies.each()) {
+    position.x += speed * dt * cos(direction);
+    position.x = std::max(playground.left + hitbox.radius, position.x);
+    position.x = std::min(playground.left + playground.width - hitbox.radius, position.x);
+
+    position.y += speed * dt * sin(direction);
+    position.y = std::max(playground.top + hitbox.radius, position.y);
+    position.y = std::min(playground.top + playground.height - hitbox.radius, position.y);
+
+    direction = fmod(direction + angular_speed * dt, 2 * physics::pi);
+  }
+}
+
+// 'detect_collisions' tel qu'il était écrit avant l'introduction de 'Kinematics'
+void legacy_detect_collisions(entt::registry& registry) {
+  auto   collidables = registry.view<Position, Hitbox>();
+  auto   candidate = registry.ctx<entt::entity>();
+  auto&& [candidate_position, candidate_speed, candidate_hitbox] =
+    registry.get<Position, physics::speed, Hitbox>(candidate);
+  auto& outcome = registry.ctx<Outcome>();
+
+  for (auto&& [entity, position, hitbox] : collidables.each()) {
+    if (entity != candidate
+    && hitbox.is_intersecting(candidate_hitbox, position - candidate_position)
+    && outcome != Outcome::candidate_collided) {
+      outcome = (candidate_speed != 0_q_m_per_s) ?
+        Outcome::candidate_collided
+      : Outcome::foe_collided;
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  auto format = bench::parse_format(argc, argv);
+
+  RobotFeatures racer_features { .hitbox {10_q_cm}, .strategy_ftor = run_circles };
+
+  for (size_t robots_nb : {10, 100, 1000, 10000}) {
+    // Terrain assez grand pour que les robots se touchent rarement
+    TrialParameters parameters {
+      .playground {0_q_m, 0_q_m, 1_q_km, 1_q_km},
+      .foe_nb = robots_nb - 1,
+      .seed = 0,
+      .dt = 0.1_q_s,
+      .time_limit = 10_q_s
+    };
+    TrialContext trial_context;
+    populate_trial(trial_context, parameters, racer_features, racer_features, false);
+    auto& registry = trial_context.get_registry();
+    set_setpoints(registry);
+
+    entt::registry legacy;
+    make_legacy_layout(registry, legacy);
+
+    auto iterations_nb = std::max<size_t>(10, 1e5 / robots_nb);
+    auto measure_per_robot = [&](auto system, entt::registry& registry) {
+      return bench::measure([&] {
+        system(registry);
+        registry.ctx<Outcome>() = Outcome::none;
+      }, iterations_nb) / robots_nb;
+    };
+
+    bench::report(std::cout, format, "update_positions<Kinematics>", robots_nb,
+                  measure_per_robot(update_positions, registry));
+    bench::report(std::cout, format, "update_positions<separate>", robots_nb,
+                  measure_per_robot(legacy_update_positions, legacy));
+    bench::report(std::cout, format, "detect_collisions<Kinematics>", robots_nb,
+                  measure_per_robot([](entt::registry& registry) {
+                    update_contacts(registry);
+                    detect_collisions(registry);
+                  }, registry));
+    bench::report(std::cout, format, "detect_collisions<separate>", robots_nb,
+                  measure_per_robot(legacy_detect_collisions, legacy));
+  }
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include "../trial.hpp"
+
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "../../benchmark.hpp"
+
+/*******************************************************************************
+  Mesurer l'effet du pas de temps sur le coût et sur l'issue des épreuves. Le
+  candidat cherche son objectif, poursuivi par des adversaires rapides : les
+  collisions sont fréquentes et, sans détection continue, des robots pourraient
+  se traverser lorsque le pas de temps augmente. Pour chaque pas de temps (le
+  paramètre, en millisecondes), on donne le nombre moyen de pas par épreuve, la
+  durée d'une épreuve en nanosecondes et la proportion d'épreuves dont l'issue
+  est celle obtenue avec le plus petit pas de temps. A compiler avec
+  GATE_HEADLESS (voir la cible 'btime_step').
+*******************************************************************************/
+
+Setpoint steer(Position translation, physics::angle direction, physics::speed max_speed) {
+  auto delta = sin(atan(translation) - direction);
+  return {
+    .speed = max_speed / (1 + 10 * std::abs(delta)),
+    .angular_speed = std::signbit(delta) ? -2_q_rad_per_s : +2_q_rad_per_s
+  };
+}
+
+Setpoint seek_goal(entt::entity entity, entt::registry& registry) {
+  return steer(get_goal(entity, registry) - registry.get<Position>(entity),
+               registry.get<Kinematics>(entity).direction, 2_q_m_per_s);
+}
+
+Setpoint chase_candidate(entt::entity entity, entt::registry& registry) {
+  auto candidate = registry.ctx<entt::entity>();
+  return steer(registry.get<Position>(candidate) - registry.get<Position>(entity),
+               registry.get<Kinematics>(entity).direction, 5_q_m_per_s);
+}
+
+int main(int argc, char** argv) {
+  auto format = bench::parse_format(argc, argv);
+
+  RobotFeatures worker_features { .hitbox {10_q_cm}, .strategy_ftor = seek_goal };
+  RobotFeatures shark_features { .hitbox {10_q_cm}, .strategy_ftor = chase_candidate };
+
+  TrialParameters parameters {
+    .playground {0_q_m, 0_q_m, 5_q_m, 4_q_m},
+    .foe_nb = 4,
+    .seed = 0,
+    .dt = 5_q_ms,
+    .time_limit = 10_q_s
+  };
+  std::vector<int64_t> seeds(200);
+  std::iota(seeds.begin(), seeds.end(), 0);
+
+  std::vector<Outcome> reference_outcomes;
+  for (auto dt : {5, 10, 20, 50, 100, 200}) {
+    parameters.dt = physics::time(dt * 1_q_ms);
+
+    double               ticks_nb = 0;
+    std::vector<Outcome> outcomes;
+    for (auto seed : seeds) {
+      parameters.seed = seed;
+      auto results = perform_trial(parameters, worker_features, shark_features);
+      ticks_nb += (results.time / parameters.dt).count();
+      outcomes.push_back(results.outcome);
+    }
+    if (reference_outcomes.empty()) reference_outcomes = outcomes;
+
+    double agreements_nb = 0;
+    for (size_t i = 0; i < seeds.size(); i++) agreements_nb += outcomes[i] == reference_outcomes[i];
+
+    auto duration = bench::measure([&] {
+      for (auto seed : seeds) {
+        parameters.seed = seed;
+        bench::keep(perform_trial(parameters, worker_features, shark_features));
+      }
+    }, 1, 5);
+
+    bench::report(std::cout, format, "ticks per trial", dt, ticks_nb / seeds.size());
+    bench::report(std::cout, format, "trial", dt, duration / seeds.size());
+    bench::report(std::cout, format, "outcome agreement", dt, agreements_nb / seeds.size());
+  }
+
+  return 0;
+}
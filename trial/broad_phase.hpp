@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "component.hpp"
+#include "math.hpp"
+#include "physics.hpp"
+
+/*******************************************************************************
+  BroadPhase range les robots dans une grille uniforme pour ne tester que les
+  paires de robots proches. Le côté d'une cellule vaut le diamètre du plus grand
+  Hitbox : deux robots en contact sont toujours dans la même cellule ou dans
+  des cellules voisines. La grille n'est pas bornée : les cellules sont
+  réparties dans une table de hachage spatiale dont la taille suit le nombre de
+  robots, et non la surface de la zone de jeu.
+
+  La grille n'est reconstruite que si une stratégie de l'épreuve déclare la
+  caractéristique 'Feature::nearest_distance', au début de chaque pas, par
+  'FeatureMatrix::extract'. La reconstruction est un tri par dénombrement des
+  robots selon leur case de la table : O(N), sans allocation une fois la taille
+  atteinte, puisque les tableaux sont conservés d'un pas et d'une épreuve à
+  l'autre (voir 'TrialContext'). Une requête ne parcourt que les cellules
+  couvertes par le disque demandé.
+*******************************************************************************/
+
+class BroadPhase {
+public:
+  struct Body {
+    entt::entity entity;
+    Position     position;
+    Hitbox       hitbox;
+    int32_t      cell_x, cell_y;
+  };
+
+  // Ranger dans la grille tous les robots du groupe 'bodies'
+  void rebuild(entt::registry& registry) {
+    auto group = bodies(registry);
+
+    max_radius = physics::length(0);
+    for (auto entity : group) max_radius = std::max(max_radius, group.get<Hitbox>(entity).radius);
+    cell_size = max_radius > physics::length(0) ? 2 * max_radius : physics::length(1);
+
+    buckets_nb = std::bit_ceil(2 * group.size() + 1);
+    bucket_starts.assign(buckets_nb + 1, 0);
+    unsorted_bodies.clear();
+    for (auto&& [entity, position, kinematics, hitbox] : group.each()) {
+      Body body { entity, position, hitbox, get_cell(position.x), get_cell(position.y) };
+      unsorted_bodies.push_back(body);
+      bucket_starts[get_bucket(body.cell_x, body.cell_y) + 1]++;
+    }
+    std::partial_sum(bucket_starts.begin(), bucket_starts.end(), bucket_starts.begin());
+
+    cursors.assign(bucket_starts.begin(), bucket_starts.end() - 1);
+    sorted_bodies.resize(unsorted_bodies.size());
+    for (const auto& body : unsorted_bodies)
+      sorted_bodies[cursors[get_bucket(body.cell_x, body.cell_y)]++] = body;
+  }
+
+  // Appeler 'ftor' pour chaque robot dont le centre est à moins de 'range' de
+  // 'center'. Si le disque couvre plus de cellules qu'il n'y a de robots, tous
+  // les robots sont parcourus.
+  template<typename F>
+  void for_each_near(const Position& center, physics::length range, F&& ftor) const {
+    auto min_x = get_cell(center.x - range), max_x = get_cell(center.x + range);
+    auto min_y = get_cell(center.y - range), max_y = get_cell(center.y + range);
+    auto is_near = [&](const Body& body) { return norm2(body.position - center) < range; };
+
+    if ((int64_t(max_x) - min_x + 1) * (int64_t(max_y) - min_y + 1) > int64_t(sorted_bodies.size())) {
+      for (const auto& body : sorted_bodies) if (is_near(body)) ftor(body);
+      return;
+    }
+
+    // Une case de la table peut contenir plusieurs cellules : seuls les robots
+    // de la cellule visitée sont retenus, pour ne voir chaque robot qu'une fois
+    for (auto cell_y = min_y; cell_y <= max_y; cell_y++) {
+      for (auto cell_x = min_x; cell_x <= max_x; cell_x++) {
+        auto bucket = get_bucket(cell_x, cell_y);
+        for (auto i = bucket_starts[bucket]; i < bucket_starts[bucket + 1]; i++) {
+          const auto& body = sorted_bodies[i];
+          if (body.cell_x == cell_x && body.cell_y == cell_y && is_near(body)) ftor(body);
+        }
+      }
+    }
+  }
+
+  // Robot le plus proche de 'entity', parmi ceux dont le centre est à moins de
+  // 'range' du sien ; nullptr s'il n'y en a aucun
+  const Body* find_nearest(entt::entity entity, const Position& center, physics::length range) const {
+    const Body*     nearest = nullptr;
+    physics::length nearest_distance = range;
+    for_each_near(center, range, [&](const Body& body) {
+      auto distance = norm2(body.position - center);
+      if (body.entity != entity && distance < nearest_distance) {
+        nearest = &body;
+        nearest_distance = distance;
+      }
+    });
+    return nearest;
+  }
+
+  //
+  physics::length get_max_radius() const { return max_radius; }
+  size_t size() const { return sorted_bodies.size(); }
+
+private:
+  // Indice de la cellule d'une coordonnée, borné avant sa conversion en entier
+  // pour qu'une position lointaine (ou NaN) ne la rende pas indéfinie. Les
+  // bornes laissent une marge d'une cellule, pour que le parcours des cellules
+  // d'une requête ne déborde pas.
+  int32_t get_cell(physics::length coordinate) const {
+    constexpr double min_cell = std::numeric_limits<int32_t>::min() + 1;
+    constexpr double max_cell = std::numeric_limits<int32_t>::max() - 1;
+    double cell = std::floor(double(coordinate.count()) / cell_size.count());
+    cell = cell > min_cell ? cell : min_cell;
+    cell = cell < max_cell ? cell : max_cell;
+    return int32_t(cell);
+  }
+
+  //
+  size_t get_bucket(int32_t cell_x, int32_t cell_y) const {
+    auto hash = uint32_t(cell_x) * 73856093u ^ uint32_t(cell_y) * 19349663u;
+    return hash & (buckets_nb - 1);
+  }
+
+  physics::length     max_radius {0};
+  physics::length     cell_size {1};
+  size_t              buckets_nb = 1;
+  std::vector<Body>   unsorted_bodies;
+  std::vector<Body>   sorted_bodies;
+  std::vector<size_t> bucket_starts = {0, 0};
+  std::vector<size_t> cursors;
+};
+
+// Ranger les robots dans la grille selon leurs positions actuelles
+void update_broad_phase(entt::registry& registry) {
+  registry.ctx_or_set<BroadPhase>().rebuild(registry);
+}
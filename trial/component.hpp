@@ -2,4 +2,6 @@
 
 #include "component/component.hpp"
 #include "component/hitbox.hpp"
+#include "component/kinematics.hpp"
+#include "component/strategy.hpp"
 #include "component/task.hpp"
@@ -5,11 +5,19 @@
 
 #include <entt/entt.hpp>
 
+#ifndef GATE_HEADLESS
 #include <SFML/Graphics.hpp>
+#endif
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
 
 #include "../physics.hpp"
 
 /*******************************************************************************
+  Lorsque GATE_HEADLESS est défini (binaire d'entraînement), aucun composant
+  graphique n'existe : seuls 'sf::Vector2' et 'sf::Rect', qui ne sont que des
+  modèles définis dans les en-têtes, sont utilisés et le programme n'a pas
+  besoin d'être lié à SFML.
 *******************************************************************************/
 
 using Playground = sf::Rect<physics::length>;
@@ -17,6 +25,7 @@ using Position = sf::Vector2<physics::length>;
 
 struct Setpoint { physics::speed speed; physics::angular_speed angular_speed; };
 using StrategyFunction = Setpoint(entt::entity, entt::registry&);
-using Strategy = std::function<StrategyFunction>;
 
+#ifndef GATE_HEADLESS
 using ShapePtr = std::unique_ptr<sf::Shape>;
+#endif
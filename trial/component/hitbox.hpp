@@ -1,6 +1,10 @@
 #pragma once
 
-#include <SFML/Graphics.hpp>
+#include <cmath>
+#include <optional>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
 
 #include <units/physical/si/base/length.h>
 
@@ -12,6 +16,11 @@
   la structure permet de gérer les collisions entre les robots. Chaque Hitbox
   est un disque centré sur un robot, qui représente le périmètre que les autres
   robots ne doivent pas franchir.
+
+  Un robot se déplace en ligne droite pendant un pas de temps (voir
+  'update_positions') : 'get_impact_fraction' teste le contact pendant tout le
+  pas, et non seulement à sa fin, pour qu'un grand pas de temps ne laisse pas
+  deux robots rapides se traverser.
 *******************************************************************************/
 
 struct Hitbox {
@@ -35,6 +44,32 @@ struct Hitbox {
     return norm2(relative_position) < radius + hitbox.radius;
   }
 
+  // Fraction du pas, entre 0 et 1, à laquelle 'hitbox' touche celui-ci ; rien
+  // s'ils ne se touchent pas pendant le pas. Les positions relatives sont
+  // celles de 'hitbox' par rapport à celui-ci, au début et à la fin du pas.
+  std::optional<physics::numeric>
+  get_impact_fraction(const Hitbox& hitbox,
+                      const sf::Vector2<Length auto>& relative_start,
+                      const sf::Vector2<Length auto>& relative_end) const {
+    using physics::numeric;
+    numeric contact = (radius + hitbox.radius).count();
+    numeric x = physics::length(relative_start.x).count();
+    numeric y = physics::length(relative_start.y).count();
+    numeric dx = physics::length(relative_end.x).count() - x;
+    numeric dy = physics::length(relative_end.y).count() - y;
+
+    // Résoudre |start + fraction * (end - start)| = contact
+    numeric c = x * x + y * y - contact * contact;
+    if (c < 0) return 0;
+    numeric a = dx * dx + dy * dy, b = 2 * (x * dx + y * dy);
+    if (b >= 0) return std::nullopt; // Les robots ne se rapprochent pas
+    numeric discriminant = b * b - 4 * a * c;
+    if (discriminant < 0) return std::nullopt;
+    numeric fraction = (-b - std::sqrt(discriminant)) / (2 * a);
+    if (fraction > 1) return std::nullopt;
+    return fraction;
+  }
+
   physics::length radius;
 
 };
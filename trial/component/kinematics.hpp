@@ -0,0 +1,28 @@
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "../physics.hpp"
+#include "component.hpp"
+#include "hitbox.hpp"
+
+/*******************************************************************************
+  Kinematics regroupe l'état d'un robot mis à jour à chaque pas : sa direction,
+  sa vitesse et sa vitesse angulaire. Avec 'Position' et 'Hitbox', ces
+  composants forment le groupe 'bodies' : l'ordre de leurs stockages est
+  maintenu identique par entt, de sorte que les systèmes physiques parcourent
+  trois tableaux contigus en parallèle, sans passer par l'indirection des
+  sparse sets. Les marques d'objectif, qui n'ont qu'une 'Position', sont
+  rangées après les robots.
+*******************************************************************************/
+
+struct Kinematics {
+  physics::angle         direction;
+  physics::speed         speed;
+  physics::angular_speed angular_speed;
+};
+
+// Robots soumis à la physique de la simulation
+inline auto bodies(entt::registry& registry) {
+  return registry.group<Position, Kinematics, Hitbox>();
+}
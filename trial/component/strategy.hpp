@@ -0,0 +1,119 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "../physics.hpp"
+#include "component.hpp"
+#include "kinematics.hpp"
+
+/*******************************************************************************
+  Les stratégies ne sont pas stockées dans chaque robot sous forme de
+  'std::function' : chaque stratégie d'une épreuve est stockée une seule fois,
+  avec son type concret, dans un 'StrategyPool' (variable de contexte du
+  registre), et chaque robot ne porte qu'un 'StrategyRef' vers elle. Les robots
+  sont ainsi regroupés par type de stratégie : pour chaque type utilisé,
+  'StrategyDispatch' contient un système qui parcourt les robots du groupe dans
+  une boucle typée statiquement, que le compilateur peut mettre en ligne. Il n'y
+  a qu'un appel indirect par type de stratégie et par pas, et non par robot.
+
+  Une stratégie qui fournit 'make_workspace' et 'decide' (comme NeuralEngine)
+  reçoit une mémoire de travail allouée une fois pour toutes à la création du
+  robot. Chaque robot a la sienne, même lorsque plusieurs robots partagent la
+  stratégie : elle peut donc conserver un état d'un pas à l'autre, comme l'état
+  caché d'un réseau récurrent.
+*******************************************************************************/
+
+template<typename StrategyFtor>
+concept WorkspaceStrategy = requires(const StrategyFtor& strategy_ftor, entt::entity entity,
+                                     entt::registry& registry) {
+  strategy_ftor.make_workspace();
+  requires requires(decltype(strategy_ftor.make_workspace()) workspace) {
+    { strategy_ftor.decide(entity, registry, workspace) } -> std::same_as<Setpoint>;
+  };
+};
+
+// Stratégies d'un même type utilisées dans l'épreuve
+template<typename StrategyFtor>
+struct StrategyPool {
+  std::vector<StrategyFtor> strategy_ftors;
+};
+
+// Stratégie d'un robot : indice dans le 'StrategyPool' de son type
+template<typename StrategyFtor>
+struct StrategyRef { size_t index; };
+
+// Mémoire de travail propre à un robot, pour une stratégie qui en utilise une
+template<WorkspaceStrategy StrategyFtor>
+struct StrategyWorkspace {
+  decltype(std::declval<const StrategyFtor&>().make_workspace()) workspace;
+};
+
+// Systèmes donnant les consignes, un par type de stratégie utilisé
+struct StrategyDispatch {
+  using System = void(entt::registry&);
+
+  // Oublier les stratégies de l'épreuve précédente (voir 'TrialContext')
+  void clear(entt::registry& registry) {
+    for (auto clear_pool : pool_clearers) clear_pool(registry);
+    systems.clear();
+    pool_clearers.clear();
+  }
+
+  std::vector<System*> systems;
+  std::vector<System*> pool_clearers;
+};
+
+// Donner une consigne à tous les robots dont la stratégie est de type
+// 'StrategyFtor'
+template<typename StrategyFtor>
+void set_typed_setpoints(entt::registry& registry) {
+  auto& pool = registry.ctx<StrategyPool<StrategyFtor>>();
+  auto  apply = [](Kinematics& kinematics, const Setpoint& setpoint) {
+    kinematics.speed = setpoint.speed;
+    kinematics.angular_speed = setpoint.angular_speed;
+  };
+
+  if constexpr (WorkspaceStrategy<StrategyFtor>) {
+    auto robots = registry.view<const StrategyRef<StrategyFtor>, StrategyWorkspace<StrategyFtor>, Kinematics>();
+    for (auto&& [entity, strategy_ref, strategy_workspace, kinematics] : robots.each())
+      apply(kinematics, pool.strategy_ftors[strategy_ref.index].decide(entity, registry,
+                                                                       strategy_workspace.workspace));
+  } else {
+    auto robots = registry.view<const StrategyRef<StrategyFtor>, Kinematics>();
+    for (auto&& [entity, strategy_ref, kinematics] : robots.each())
+      apply(kinematics, pool.strategy_ftors[strategy_ref.index](entity, registry));
+  }
+}
+
+// Stocker une stratégie dans le registre, pour un ou plusieurs robots
+template<typename StrategyFtor>
+StrategyRef<StrategyFtor> add_strategy(entt::registry& registry, const StrategyFtor& strategy_ftor) {
+  auto& pool = registry.ctx_or_set<StrategyPool<StrategyFtor>>();
+  if (pool.strategy_ftors.empty()) {
+    auto& dispatch = registry.ctx_or_set<StrategyDispatch>();
+    dispatch.systems.push_back(set_typed_setpoints<StrategyFtor>);
+    dispatch.pool_clearers.push_back([](entt::registry& registry) {
+      registry.ctx<StrategyPool<StrategyFtor>>().strategy_ftors.clear();
+    });
+  }
+
+  pool.strategy_ftors.push_back(strategy_ftor);
+  return {pool.strategy_ftors.size() - 1};
+}
+
+// Donner à un robot une stratégie stockée dans le registre, ainsi que sa propre
+// mémoire de travail si la stratégie en utilise une
+template<typename StrategyFtor>
+void assign_strategy(entt::registry& registry, entt::entity entity, StrategyRef<StrategyFtor> strategy_ref) {
+  registry.emplace<StrategyRef<StrategyFtor>>(entity, strategy_ref);
+  if constexpr (WorkspaceStrategy<StrategyFtor>) {
+    const auto& pool = registry.ctx<StrategyPool<StrategyFtor>>();
+    auto workspace = pool.strategy_ftors[strategy_ref.index].make_workspace();
+    registry.emplace<StrategyWorkspace<StrategyFtor>>(entity, StrategyWorkspace<StrategyFtor> {std::move(workspace)});
+  }
+}
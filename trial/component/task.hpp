@@ -13,20 +13,24 @@
 #include "hitbox.hpp"
 
 /*******************************************************************************
+  Task associe un robot à l'entité qui marque son objectif. La tâche ne contient
+  que l'identifiant de cette entité : elle est lue à chaque pas par les
+  stratégies et les fetchers, et doit pouvoir être copiée pour rien. Pour
+  accéder à l'objectif d'un robot, 'get_goal' retourne directement une
+  référence sur sa position.
 *******************************************************************************/
 
 class Task {
 public:
-  Task(entt::entity entity, entt::registry& registry) : entity(entity) {}
+  Task(entt::entity entity) : entity(entity) {}
 
-  //
-  bool update(entt::entity worker, entt::registry& registry) {
+  // Tirer un nouvel objectif lorsque 'worker' a atteint le sien. Retourne 'true'
+  // si l'objectif a été atteint.
+  bool update(entt::entity worker, entt::registry& registry) const {
     const auto& task_position = registry.get<Position>(entity);
-    auto&&      [position, speed] = registry.get<Position, physics::speed>(worker);
-    auto        dt = registry.ctx<TrialParameters>().dt;
+    const auto& position = registry.get<Position>(worker);
 
     if (norm2(position - task_position) < 5_q_cm) { //TODO : change
-      const auto& hitbox = registry.get<Hitbox>(worker);
       const auto& playground = registry.ctx<TrialParameters>().playground;
       auto&       rnd_engine = registry.ctx<std::mt19937>();
 
@@ -44,6 +48,12 @@ public:
 
 private:
   entt::entity entity;
-  std::mt19937 rnd_engine;
 
 };
+
+static_assert(sizeof(Task) == sizeof(entt::entity));
+
+// Position de l'objectif de 'worker'
+inline const Position& get_goal(entt::entity worker, const entt::registry& registry) {
+  return registry.get<Position>(registry.get<Task>(worker).get_entity());
+}
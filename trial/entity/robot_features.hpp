@@ -1,12 +1,15 @@
 #pragma once
 
 #include <concepts>
+#include <type_traits>
 
 #include <boost/callable_traits/return_type.hpp>
 
 #include <entt/entt.hpp>
 
+#ifndef GATE_HEADLESS
 #include <SFML/Graphics.hpp>
+#endif
 
 #include <units/random.h>
 
@@ -15,50 +18,84 @@
 #include "../position_picker.hpp"
 #include "../trial_parameters.hpp"
 
+/*******************************************************************************
+  RobotFeatures décrit un robot : sa forme physique, sa stratégie et, pour
+  l'affichage, les formes du robot et de la marque de son objectif. Sans
+  affichage (GATE_HEADLESS), ces formes sont de type 'NoShape' et n'occupent
+  aucune place.
+*******************************************************************************/
+
+struct NoShape {};
+
+#ifdef GATE_HEADLESS
+template<typename T>
+concept RobotShape = std::same_as<T, NoShape>;
+#else
+template<typename T>
+concept RobotShape = std::same_as<T, NoShape> || std::derived_from<T, sf::Shape>;
+#endif
+
 template<
   std::invocable<entt::entity, entt::registry&> StrategyFtor,
-  std::derived_from<sf::Shape> Shape,
-  std::derived_from<sf::Shape> GoalMarkShape
+  RobotShape Shape = NoShape,
+  RobotShape GoalMarkShape = NoShape
 > requires std::same_as<boost::callable_traits::return_type_t<StrategyFtor>, Setpoint>
 struct RobotFeatures {
   Hitbox       hitbox;
   StrategyFtor strategy_ftor;
 
-  Shape         shape;
-  GoalMarkShape goal_mark_shape;
+  [[no_unique_address]] Shape         shape;
+  [[no_unique_address]] GoalMarkShape goal_mark_shape;
 };
 
-//
+// Créer un robot dont la stratégie est déjà stockée dans le registre (voir
+// 'add_strategy'), ce qui permet de la partager entre plusieurs robots
+template<typename StrategyFtor>
 entt::entity create_robot(entt::registry& registry,
-                          const RobotFeatures<auto, auto, auto>& robot_features,
-                          bool shall_display) {
+                          const RobotFeatures<StrategyFtor, auto, auto>& robot_features,
+                          [[maybe_unused]] bool shall_display,
+                          StrategyRef<StrategyFtor> strategy_ref) {
   using units::uniform_real_distribution;
 
   const auto& playground = registry.ctx<TrialParameters>().playground;
         auto& rnd_engine = registry.ctx<std::mt19937>();
-  const auto& [hitbox, strategy_ftor, shape, goal_mark_shape] = robot_features;
+  [[maybe_unused]] const auto& [hitbox, strategy_ftor, shape, goal_mark_shape] = robot_features;
   PositionPicker pick_position(playground);
   uniform_real_distribution<physics::angle> pick_angle(0_q_rad, 2 * physics::pi);
 
   // Créer les plus simples composants du robot
   auto entity = registry.create();
   registry.emplace<Position>(entity, pick_position(rnd_engine));
-  registry.emplace<physics::speed>(entity, 0);
-  registry.emplace<physics::angular_speed>(entity, 0);
-  registry.emplace<physics::angle>(entity, pick_angle(rnd_engine));
+  registry.emplace<Kinematics>(entity, Kinematics {
+    .direction = pick_angle(rnd_engine),
+    .speed = physics::speed(0),
+    .angular_speed = physics::angular_speed(0)
+  });
   registry.emplace<Hitbox>(entity, hitbox);
-  registry.emplace<Strategy>(entity, strategy_ftor);
+  assign_strategy(registry, entity, strategy_ref);
 
   // Créer une tâche pour le robot
   auto task_entity = registry.create();
   registry.emplace<Position>(task_entity, pick_position(rnd_engine));
-  registry.emplace<Task>(entity, task_entity, registry);
+  registry.emplace<Task>(entity, task_entity);
 
   // Créer des composants graphiques si besoin
+#ifndef GATE_HEADLESS
   if (shall_display) {
-    registry.emplace<ShapePtr>(task_entity, new auto(goal_mark_shape));
-    registry.emplace<ShapePtr>(entity, new auto(shape));
+    if constexpr (!std::same_as<std::remove_cvref_t<decltype(goal_mark_shape)>, NoShape>)
+      registry.emplace<ShapePtr>(task_entity, new auto(goal_mark_shape));
+    if constexpr (!std::same_as<std::remove_cvref_t<decltype(shape)>, NoShape>)
+      registry.emplace<ShapePtr>(entity, new auto(shape));
   }
+#endif
 
   return entity;
 }
+
+//
+entt::entity create_robot(entt::registry& registry,
+                          const RobotFeatures<auto, auto, auto>& robot_features,
+                          bool shall_display) {
+  return create_robot(registry, robot_features, shall_display,
+                      add_strategy(registry, robot_features.strategy_ftor));
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "../neural/linear.hpp"
+#include "broad_phase.hpp"
+#include "component.hpp"
+#include "math.hpp"
+#include "physics.hpp"
+
+/*******************************************************************************
+  Extraction des caractéristiques ('features') des robots. Plutôt que de laisser
+  chaque fetcher de chaque stratégie interroger le registre, les caractéristiques
+  déclarées par les stratégies d'une épreuve sont calculées une fois par pas,
+  pour tous les robots, dans une matrice : une ligne par caractéristique, une
+  colonne par robot. Le vecteur vers l'objectif, sa norme et l'angle relatif ne
+  sont calculés qu'une fois par robot, quel que soit le nombre de
+  caractéristiques qui en dépendent.
+
+  La colonne d'un robot est indiquée par son composant 'FeatureColumn' ; elle
+  peut être utilisée directement comme entrée d'un réseau de neurones, et la
+  matrice entière comme un lot d'entrées.
+*******************************************************************************/
+
+enum class Feature {
+  sin_to_goal,      // sin(angle vers l'objectif - direction)
+  cos_to_goal,      // cos(angle vers l'objectif - direction)
+  distance_to_goal, // en mètres
+  speed,            // en mètres par seconde
+  x_position,       // en mètres
+  y_position,       // en mètres
+  nearest_distance, // distance au centre du robot le plus proche, en mètres,
+                    // bornée par la portée des capteurs de proximité
+};
+
+inline constexpr size_t feature_nb = 7;
+
+// Portée des capteurs de proximité
+inline constexpr auto proximity_range = physics::length(2);
+
+struct FeatureColumn { Eigen::Index index; };
+
+class FeatureMatrix {
+public:
+  FeatureMatrix() {
+    reset();
+  }
+
+  // Ajouter des caractéristiques à calculer à chaque pas
+  void declare(const std::vector<Feature>& new_features) {
+    for (auto feature : new_features) {
+      if (is_declared(feature)) continue;
+      rows[size_t(feature)] = features.size();
+      features.push_back(feature);
+    }
+  }
+
+  // Ne plus calculer aucune caractéristique
+  void reset() {
+    features.clear();
+    rows.fill(-1);
+  }
+
+  //
+  bool is_empty() const {
+    return features.empty();
+  }
+  bool is_declared(Feature feature) const {
+    return rows[size_t(feature)] >= 0;
+  }
+
+  // Calculer les caractéristiques déclarées pour tous les robots. La grille
+  // n'est reconstruite que si la distance au robot le plus proche est déclarée :
+  // elle n'a pas d'autre lecteur.
+  void extract(entt::registry& registry) {
+    auto robots = registry.view<const Position, const Kinematics, const Task>();
+    const BroadPhase* broad_phase = nullptr;
+    if (is_declared(Feature::nearest_distance)) {
+      update_broad_phase(registry);
+      broad_phase = &registry.ctx<BroadPhase>();
+    }
+    values.resize(features.size(), robots.size_hint());
+
+    Eigen::Index column = 0;
+    for (auto&& [entity, position, kinematics, task] : robots.each()) {
+      const auto& [direction, speed, angular_speed] = kinematics;
+      registry.get_or_emplace<FeatureColumn>(entity).index = column;
+      auto translation = registry.get<Position>(task.get_entity()) - position;
+      auto delta = atan(translation) - direction;
+
+      for (Eigen::Index row = 0; row < (Eigen::Index) features.size(); row++) {
+        switch (features[row]) {
+        case Feature::sin_to_goal:      values(row, column) = sin(delta); break;
+        case Feature::cos_to_goal:      values(row, column) = cos(delta); break;
+        case Feature::distance_to_goal: values(row, column) = norm2(translation).count(); break;
+        case Feature::speed:            values(row, column) = speed.count(); break;
+        case Feature::x_position:       values(row, column) = position.x.count(); break;
+        case Feature::y_position:       values(row, column) = position.y.count(); break;
+        case Feature::nearest_distance: values(row, column) = get_nearest_distance(entity, position, *broad_phase); break;
+        }
+      }
+      column++;
+    }
+  }
+
+  // Valeur d'une caractéristique déclarée pour le robot de la colonne 'column'
+  double operator()(Feature feature, Eigen::Index column) const {
+    return values(rows[size_t(feature)], column);
+  }
+
+  // Toutes les caractéristiques déclarées d'un robot, dans l'ordre de déclaration
+  auto column(entt::entity entity, const entt::registry& registry) const {
+    return values.col(registry.get<FeatureColumn>(entity).index);
+  }
+
+  //
+  const std::vector<Feature>& get_features() const { return features; }
+  const neural::Matrix<double>& get_values() const { return values; }
+
+private:
+  //
+  static double get_nearest_distance(entt::entity entity, const Position& position,
+                                     const BroadPhase& broad_phase) {
+    auto* nearest = broad_phase.find_nearest(entity, position, proximity_range);
+    return nearest ? norm2(nearest->position - position).count() : proximity_range.count();
+  }
+
+  std::vector<Feature>                 features;
+  std::array<Eigen::Index, feature_nb> rows;
+  neural::Matrix<double>               values;
+};
+
+// Déclarer les caractéristiques utilisées par une stratégie, si elle en utilise
+void declare_features(FeatureMatrix& feature_matrix, const auto& strategy_ftor) {
+  if constexpr (requires { strategy_ftor.get_features(); })
+    feature_matrix.declare(strategy_ftor.get_features());
+}
+
+// Calculer les caractéristiques d'un pas, si des stratégies de l'épreuve en ont
+// déclaré
+void extract_features(entt::registry& registry) {
+  if (auto* feature_matrix = registry.try_ctx<FeatureMatrix>(); feature_matrix && !feature_matrix->is_empty())
+    feature_matrix->extract(registry);
+}
@@ -8,12 +8,50 @@
 // TODO : trouver une solution
 
 #include "../component.hpp"
+#include "../physics.hpp"
+#include "../trial_parameters.hpp"
 
 /*template<typename T>
 concept Drawables =
    std::ranges::range<T>
 && requires(T t) { { *t.begin() } -> std::derived_from<sf::Drawable>; };*/
 
+//
+auto create_playground_sprite(entt::registry& registry) {
+  auto entity = registry.create();
+  const auto& playground = registry.ctx<TrialParameters>().playground;
+  Position position{playground.left, playground.top};
+  Position size{playground.width, playground.height};
+
+  sf::RectangleShape playground_sprite(physics::cast_for_display(size));
+  playground_sprite.setPosition(physics::cast_for_display(position));
+  playground_sprite.setFillColor({0, 0, 0, 0});
+  playground_sprite.setOutlineColor(sf::Color::White);
+  playground_sprite.setOutlineThickness(5);
+  registry.emplace<ShapePtr>(entity, new sf::RectangleShape(playground_sprite));
+
+  return physics::cast_for_display(position) + physics::cast_for_display(size) / 2.f;
+}
+
+//
+void position_sprites(entt::registry& registry) {
+  auto positionables = registry.view<Position, ShapePtr>();
+  for (auto&& [entity, position, shape_ptr] : positionables.each()) {
+    const auto& local_bounds = shape_ptr->getLocalBounds();
+    sf::Vector2f recentring_translation(-local_bounds.width / 2, -local_bounds.height / 2);
+    shape_ptr->setOrigin(-physics::cast_for_display(position));
+    shape_ptr->setPosition(recentring_translation);
+  }
+}
+
+#pragma message "Réactiver 'rotate_sprites'"
+//
+void rotate_sprites(entt::registry& registry) {
+  /*auto rotatables = registry.view<Kinematics, ShapePtr>();
+  for (auto&& [entity, kinematics, shape_ptr] : rotatables.each())
+    shape_ptr->setRotation(physics::cast_for_display(kinematics.direction));*/
+}
+
 //
 void display(sf::RenderWindow& render_window, entt::registry& registry) {
   render_window.clear();
@@ -21,10 +59,8 @@ void display(sf::RenderWindow& render_window, entt::registry& registry) {
   for (auto&& [entity, shape_ptr] : drawables) render_window.draw(*shape_ptr);
   // TODO : remove
   auto entity  = registry.ctx<entt::entity>();
-  auto task_entity = registry.get<Task>(entity).get_entity();
-  auto speed = registry.get<physics::speed>(entity);
-  auto angular_speed = registry.get<physics::angular_speed>(entity);
-  auto distance = norm2(registry.get<Position>(entity) - registry.get<Position>(task_entity));
+  auto [direction, speed, angular_speed] = registry.get<Kinematics>(entity);
+  auto distance = norm2(registry.get<Position>(entity) - get_goal(entity, registry));
   sf::Text speed_text;
   sf::Text angular_speed_text;
   sf::Text distance_text;
@@ -12,46 +12,14 @@
 #include "math.hpp"
 #include "physics.hpp"
 
-double sin_delta(entt::entity entity, entt::registry& registry) {
-  auto task = registry.get<Task>(entity);
-  auto goal = registry.get<Position>(task.get_entity());
-  auto direction = registry.get<physics::angle>(entity);
-  return sin(atan(registry.get<Position>(entity) - goal) - direction);
-}
-
-double cos_delta(entt::entity entity, entt::registry& registry) {
-  auto task = registry.get<Task>(entity);
-  auto goal = registry.get<Position>(task.get_entity());
-  auto direction = registry.get<physics::angle>(entity);
-  return cos(atan(registry.get<Position>(entity) - goal) - direction);
-}
-
-double speed(entt::entity entity, entt::registry& registry) {
-  return registry.get<physics::speed>(entity).count();
-}
-
-double distance_to_goal(entt::entity entity, entt::registry& registry) {
-  auto task = registry.get<Task>(entity);
-  auto goal = registry.get<Position>(task.get_entity());
-  return norm2(registry.get<Position>(entity) - goal).count();
-}
-
-double x_position(entt::entity entity, entt::registry& registry) {
-  return registry.get<Position>(entity).x.count();
-}
-
-double y_position(entt::entity entity, entt::registry& registry) {
-  return registry.get<Position>(entity).y.count();
-}
-
-
-double bias(entt::entity, entt::registry&) {
-  return 1.0;
-}
+// Les individus gardent la sigmoïde exacte : c'est le type que 'best.nn' doit
+// avoir pour être relu par un 'NeuralEngine<>'. Les épreuves, elles, utilisent
+// une copie à sigmoïde tabulée, plus rapide
+using FastNeuralEngine = NeuralEngine<double, neural::tabulated_sigmoid<double>>;
 
 template<typename... Args>
 auto make_batch(size_t nb, Args&&... args) {
-  std::vector<NeuralEngine> batch;
+  std::vector<NeuralEngine<>> batch;
   for (size_t i = 0; i < nb; i++)
     batch.emplace_back(std::forward<Args>(args)...);
   return batch;
@@ -61,20 +29,31 @@ int main() {
   using namespace genetics;
   using std::ranges::begin;
 
-  //
-  auto batch = make_batch(50, 15,
-    sin_delta,
-    cos_delta,
-    //speed,
-    distance_to_goal,
-    //x_position,
-    //y_position,
-    bias);
+  // Caractéristiques calculées une fois par pas et lues par tous les candidats
+  std::vector<Feature> input_features {
+    Feature::sin_to_goal,
+    Feature::cos_to_goal,
+    //Feature::speed,
+    Feature::distance_to_goal,
+    //Feature::x_position,
+    //Feature::y_position
+  };
+  auto batch = make_batch(50, 15, input_features);
   RobotFeatures neural_features {
     .hitbox {10_q_cm},
-    .strategy_ftor = NeuralEngine(0),
+    .strategy_ftor = batch.front(),
+#ifndef GATE_HEADLESS
     .shape = sf::CircleShape(physics::cast_for_display(10_q_cm)),
     .goal_mark_shape = sf::CircleShape(physics::cast_for_display(5_q_cm))
+#endif
+  };
+  RobotFeatures fast_neural_features {
+    .hitbox {10_q_cm},
+    .strategy_ftor = FastNeuralEngine(batch.front()),
+#ifndef GATE_HEADLESS
+    .shape = sf::CircleShape(physics::cast_for_display(10_q_cm)),
+    .goal_mark_shape = sf::CircleShape(physics::cast_for_display(5_q_cm))
+#endif
   };
   TrialParameters parameters {
     .playground {0_q_m, 0_q_m, 5_q_m, 5_q_m },
@@ -87,8 +66,8 @@ int main() {
   //
   int64_t seeds[10];
   auto fitness_ftor = [&](auto& candidate) {
-    auto features = neural_features;
-    features.strategy_ftor = candidate;
+    auto features = fast_neural_features;
+    features.strategy_ftor = FastNeuralEngine(candidate);
     double fitness = 0;
     size_t nb_sucess = 0;
 
@@ -113,7 +92,7 @@ int main() {
   std::normal_distribution make_noise(0.0, 1.0);
   int                      elitism = 15;
 
-  auto best_features = neural_features;
+  auto best_features = fast_neural_features;
   for (auto& candidate : batch) {
     mutate(candidate.view(), 1.0, [&](auto& value, auto& rnd_engine) { value = make_noise(rnd_engine); });
   }
@@ -128,8 +107,10 @@ int main() {
                                         | ltl::map([&](const auto& x) { return x - worst_fitness; });
     std::discrete_distribution pick_index(positive_fitnesses);
 
-    best_features.strategy_ftor = batch.front();
-    perform_trial(parameters, best_features, neural_features, true);
+#ifndef GATE_HEADLESS
+    best_features.strategy_ftor = FastNeuralEngine(batch.front());
+    perform_trial(parameters, best_features, fast_neural_features, true);
+#endif
     std::wcout << std::endl;
     std::wcout << "BATCH " << i << " --- Best : " << fitnesses[0] << ", "
                                                   << fitnesses[1] << ", "
@@ -138,24 +119,29 @@ int main() {
     for (auto& candidate : batch | ltl::drop_n(elitism)) {
       candidate = batch[pick_index(rnd_engine)];
       auto copy = batch[pick_index(rnd_engine)];
-      crossover_uniform(candidate.view(), copy.view());
+      crossover_blocks(candidate.neurons(), copy.neurons());
       mutate(candidate.view(), 0.001, [&](auto& value, auto& rnd_engine) { value = make_noise(rnd_engine); });
     }
   }
 
+  batch.front().save("best.nn");
+  std::wcout << "Meilleur individu sauvegardé dans best.nn" << std::endl;
+
   std::ofstream log("log.txt");
   neural_features.strategy_ftor = batch.front();
   measure_accuracy(1e4, parameters, neural_features, neural_features, log);
 
+#ifndef GATE_HEADLESS
   std::wstring answer, yes(L"o"), no(L"n");
   std::wcout << "Faire une démonstration ?" << std::endl;
   std::wcin >> answer;
   while (answer == yes) {
     parameters.seed = generate_seed();
-    perform_trial(parameters, best_features, neural_features, true);
+    perform_trial(parameters, best_features, fast_neural_features, true);
     std::wcout << "Recommencer ?" << std::endl;
     std::wcin >> answer;
   }
+#endif
 
   return 0;
 }
@@ -3,50 +3,38 @@
 #include <entt/entt.hpp>
 
 #include "component.hpp"
+#include "feature_extraction.hpp"
 #include "math.hpp"
 #include "outcome.hpp"
 #include "physics.hpp"
+#include "sweep_and_prune.hpp"
+#include "trial_parameters.hpp"
 
 //TODO : remove
 #include <iostream>
 
 /*******************************************************************************
-
+  Systèmes de la simulation. Aucun n'utilise de composant graphique : les
+  systèmes d'affichage se trouvent dans 'io/render.hpp'.
 *******************************************************************************/
 
-//
-auto create_playground_sprite(entt::registry& registry) {
-  auto entity = registry.create();
-  const auto& playground = registry.ctx<TrialParameters>().playground;
-  Position position{playground.left, playground.top};
-  Position size{playground.width, playground.height};
-
-  sf::RectangleShape playground_sprite(physics::cast_for_display(size));
-  playground_sprite.setPosition(physics::cast_for_display(position));
-  playground_sprite.setFillColor({0, 0, 0, 0});
-  playground_sprite.setOutlineColor(sf::Color::White);
-  playground_sprite.setOutlineThickness(5);
-  registry.emplace<ShapePtr>(entity, new sf::RectangleShape(playground_sprite));
-
-  return physics::cast_for_display(position) + physics::cast_for_display(size) / 2.f;
-}
-
-//
+// Donner une consigne à chaque robot, groupe de stratégie par groupe de
+// stratégie (voir 'component/strategy.hpp')
 void set_setpoints(entt::registry& registry) {
-  auto robots = registry.view<Strategy, physics::speed, physics::angular_speed>();
-  for (auto&& [entity, strategy, speed, angular_speed] : robots.each()) {
-    auto setpoint = strategy(entity, registry);
-    speed = setpoint.speed;
-    angular_speed = setpoint.angular_speed;
-  }
+  if (auto* dispatch = registry.try_ctx<StrategyDispatch>())
+    for (auto set_typed_setpoints : dispatch->systems) set_typed_setpoints(registry);
 }
 
-//
+// Un robot se déplace en ligne droite pendant un pas. La zone de jeu étant un
+// rectangle aligné sur les axes, borner chaque coordonnée revient à arrêter le
+// robot contre le bord à l'instant de l'impact puis à le faire glisser le long
+// du bord : aucun pas de temps, si grand soit-il, ne fait sortir un robot de la
+// zone de jeu.
 void update_positions(entt::registry& registry) {
-  auto bodies = registry.view<Position, Hitbox, physics::angle, physics::speed, physics::angular_speed>();
   const auto& playground = registry.ctx<TrialParameters>().playground;
   auto dt = registry.ctx<TrialParameters>().dt;
-  for (auto&& [entity, position, hitbox, direction, speed, angular_speed] : bodies.each()) {
+  for (auto&& [entity, position, kinematics, hitbox] : bodies(registry).each()) {
+    auto& [direction, speed, angular_speed] = kinematics;
     position.x += speed * dt * cos(direction);
     position.x = std::max(playground.left + hitbox.radius, position.x);
     position.x = std::min(playground.left + playground.width - hitbox.radius, position.x);
@@ -59,45 +47,24 @@ void update_positions(entt::registry& registry) {
   }
 }
 
-//
-void position_sprites(entt::registry& registry) {
-  auto positionables = registry.view<Position, ShapePtr>();
-  for (auto&& [entity, position, shape_ptr] : positionables.each()) {
-    const auto& local_bounds = shape_ptr->getLocalBounds();
-    sf::Vector2f recentring_translation(-local_bounds.width / 2, -local_bounds.height / 2);
-    shape_ptr->setOrigin(-physics::cast_for_display(position));
-    shape_ptr->setPosition(recentring_translation);
-  }
-}
-
-#pragma message "Réactiver 'rotate_sprites'"
-//
-void rotate_sprites(entt::registry& registry) {
-  /*auto rotatables = registry.view<physics::angle, ShapePtr>();
-  for (auto&& [entity, direction, shape_ptr] : rotatables.each())
-    shape_ptr->setRotation(physics::cast_for_display(direction));*/
-}
-
 //
 void update_tasks(entt::registry& registry) {
   auto workers = registry.view<Position, Task>();
   auto candidate = registry.ctx<entt::entity>();
   for (auto&& [entity, position, task] : workers.each())
     if (task.update(entity, registry) && entity == candidate)
-      registry.set<Outcome>(Outcome::goal_reached);
+      registry.ctx<Outcome>() = Outcome::goal_reached;
 }
 
-//
+// Seuls les contacts du candidat comptent ; ils sont lus parmi les contacts du
+// pas, détectés en continu (voir 'sweep_and_prune.hpp')
 void detect_collisions(entt::registry& registry) {
-  auto   collidables = registry.view<Position, Hitbox>();
-  auto   candidate = registry.ctx<entt::entity>();
-  auto&& [candidate_position, candidate_speed, candidate_hitbox] =
-    registry.get<Position, physics::speed, Hitbox>(candidate);
+  auto  candidate = registry.ctx<entt::entity>();
+  auto  candidate_speed = registry.get<Kinematics>(candidate).speed;
   auto& outcome = registry.ctx<Outcome>();
 
-  for (auto&& [entity, position, hitbox] : collidables.each()) {
-    if (entity != candidate
-    && hitbox.is_intersecting(candidate_hitbox, position - candidate_position)
+  for (const auto& contact : registry.ctx<SweepAndPrune>().get_contacts()) {
+    if ((contact.first == candidate || contact.second == candidate)
     && outcome != Outcome::candidate_collided) {
       outcome = (candidate_speed != 0_q_m_per_s) ?
         Outcome::candidate_collided
@@ -108,6 +75,15 @@ void detect_collisions(entt::registry& registry) {
 
 //
 physics::length get_distance_to_goal(entt::entity entity, entt::registry& registry) {
-  auto task_entity = registry.get<Task>(entity).get_entity();
-  return norm2(registry.get<Position>(entity) - registry.get<Position>(task_entity));
+  return norm2(registry.get<Position>(entity) - get_goal(entity, registry));
+}
+
+// Faire avancer la simulation d'un pas de temps
+void update_trial(entt::registry& registry) {
+  extract_features(registry);
+  set_setpoints(registry);
+  update_positions(registry);
+  update_contacts(registry);
+  update_tasks(registry);
+  detect_collisions(registry);
 }
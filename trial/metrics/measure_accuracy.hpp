@@ -1,5 +1,7 @@
 #pragma once
 
+#include <concepts>
+
 #include "../trial.hpp" //TODO : restructurer
 #include "ltl/Range/Value.h"
 
@@ -7,28 +9,40 @@
   Lorsque l'entraînement est terminé, il est nécessaire de mesurer les performances
   du réseau de neurone. La fonction 'measure_accuracy' soumet le candidat déterminé
   par 'candidate_features' à une série d'épreuves. La fonction s'occupe de fournir
-  une seed pour chaque épreuve. La fonction envoie à 'out_stream' les résultats
-  de la mesure.
+  une seed pour chaque épreuve (par défaut avec 'generate_seed', ou avec le
+  foncteur 'pick_seed' pour rejouer la même série d'épreuves). La fonction envoie
+  à 'out_stream' les résultats de la mesure et les retourne.
 *******************************************************************************/
 
+struct AccuracyResults {
+  size_t          success_nb;
+  physics::time   average_time;
+  physics::length average_closeness;
+  physics::length worst_closeness;
+  double          average_contacts_nb; // Contacts entre robots par épreuve
+};
+
 template<typename C>
-void measure_accuracy(int trials_nb, TrialParameters& parameters,
-                      const RobotFeatures<auto, auto, auto>& candidate_features,
-                      const RobotFeatures<auto, auto, auto>& foe_features,
-                      std::basic_ostream<C>& out_stream) {
+AccuracyResults measure_accuracy(int trials_nb, TrialParameters& parameters,
+                                 const RobotFeatures<auto, auto, auto>& candidate_features,
+                                 const RobotFeatures<auto, auto, auto>& foe_features,
+                                 std::basic_ostream<C>& out_stream,
+                                 std::invocable auto&& pick_seed) {
   physics::time average_time = 0_q_s;
   physics::length average_closeness = 0_q_m;
   physics::length worst_closeness = 0_q_m;
   size_t success_nb = 0;
+  size_t contacts_nb = 0;
 
   out_stream << "Série de " << trials_nb << " épreuves" << std::endl;
   out_stream << std::endl;
 
   for (auto i : ltl::valueRange(0, trials_nb)) {
-    parameters.seed = generate_seed();
+    parameters.seed = pick_seed();
     out_stream << "Epreuve " << i << " / " << trials_nb << " --- ";
 
     auto results = perform_trial(parameters, candidate_features, foe_features);
+    contacts_nb += results.contacts_nb;
     out_stream << "Issue : " << (results.outcome == Outcome::goal_reached ? "SUCCES" : "ECHEC") << " - ";
     if (results.outcome == Outcome::goal_reached) {
       success_nb++;
@@ -50,5 +64,23 @@ void measure_accuracy(int trials_nb, TrialParameters& parameters,
              << "Succès : " << success_nb * 100 / trials_nb << "%" << std::endl
              << "Temps moyen : " << average_time.count() << std::endl
              << "Proximité moyenne : " << average_closeness.count() << std::endl
-             << "Pire proximité : " << worst_closeness.count() << std::endl;
+             << "Pire proximité : " << worst_closeness.count() << std::endl
+             << "Contacts par épreuve : " << double(contacts_nb) / trials_nb << std::endl;
+
+  return {
+    .success_nb = success_nb,
+    .average_time = average_time,
+    .average_closeness = average_closeness,
+    .worst_closeness = worst_closeness,
+    .average_contacts_nb = double(contacts_nb) / trials_nb
+  };
+}
+
+template<typename C>
+AccuracyResults measure_accuracy(int trials_nb, TrialParameters& parameters,
+                                 const RobotFeatures<auto, auto, auto>& candidate_features,
+                                 const RobotFeatures<auto, auto, auto>& foe_features,
+                                 std::basic_ostream<C>& out_stream) {
+  return measure_accuracy(trials_nb, parameters, candidate_features, foe_features,
+                          out_stream, generate_seed);
 }
@@ -0,0 +1,90 @@
+#include "../neural_engine.hpp"
+
+#include <iostream>
+#include <random>
+#include <string>
+
+#include <SFML/Graphics.hpp>
+
+#include "../../../benchmark.hpp"
+#include "../../../genetics/genetics.hpp"
+#include "../../entity/robot_features.hpp"
+
+/*******************************************************************************
+  Mesurer le coût complet d'une décision de NeuralEngine, fetchers compris, en
+  double et simple précision et pour plusieurs fonctions d'activation de sortie.
+  Le robot est créé dans un registre comme pour une épreuve, et les fetchers
+  sont ceux utilisés pour l'entraînement. Les résultats sont écrits sur la sortie
+  standard en CSV, ou en JSON Lines avec l'option '--json'. Le paramètre est la
+  taille de la couche cachée.
+*******************************************************************************/
+
+Setpoint dont_move(entt::entity, entt::registry&) {
+  return { .speed = 0_q_m_per_s, .angular_speed = 0_q_rad_per_s };
+}
+
+double sin_to_goal(entt::entity entity, entt::registry& registry) {
+  const auto& goal = get_goal(entity, registry);
+  return sin(atan(goal - registry.get<Position>(entity)) - registry.get<Kinematics>(entity).direction);
+}
+
+double cos_to_goal(entt::entity entity, entt::registry& registry) {
+  const auto& goal = get_goal(entity, registry);
+  return cos(atan(goal - registry.get<Position>(entity)) - registry.get<Kinematics>(entity).direction);
+}
+
+double distance_to_goal(entt::entity entity, entt::registry& registry) {
+  const auto& goal = get_goal(entity, registry);
+  return norm2(goal - registry.get<Position>(entity)).count();
+}
+
+template<typename Scalar, auto& OutputActivation>
+void run(bench::Format format, std::string_view name, int hidden_layer_size,
+         entt::entity entity, entt::registry& registry) {
+  std::mt19937             rnd_engine(1337);
+  std::normal_distribution make_noise(0.0, 1.0);
+
+  NeuralEngine<Scalar, OutputActivation> neural_engine(hidden_layer_size, sin_to_goal,
+                                                       cos_to_goal, distance_to_goal);
+  genetics::mutate(neural_engine.view(), 1.0, [&](auto& x, auto&) { x = make_noise(rnd_engine); });
+  auto workspace = neural_engine.make_workspace();
+
+  bench::report(std::cout, format, std::string(name) + "::operator()", hidden_layer_size,
+                bench::measure([&] { bench::keep(neural_engine(entity, registry)); }));
+  bench::report(std::cout, format, std::string(name) + "::decide", hidden_layer_size,
+                bench::measure([&] { bench::keep(neural_engine.decide(entity, registry, workspace)); }));
+}
+
+int main(int argc, char** argv) {
+  auto format = bench::parse_format(argc, argv);
+
+  entt::registry registry;
+  registry.set<std::mt19937>(1337);
+  registry.set<TrialParameters>(TrialParameters {
+    .playground {0_q_m, 0_q_m, 5_q_m, 5_q_m },
+    .foe_nb = 0,
+    .seed = 1337,
+    .dt = 0.1_q_s,
+    .time_limit = 10_q_s
+  });
+  RobotFeatures robot_features {
+    .hitbox { 10_q_cm },
+    .strategy_ftor = dont_move,
+    .shape = sf::CircleShape(0),
+    .goal_mark_shape = sf::CircleShape(0)
+  };
+  auto entity = create_robot(registry, robot_features, false);
+
+  for (auto hidden_layer_size : {4, 16, 64, 256, 1024}) {
+    run<double, neural::sigmoid<double>>(format, "NeuralEngine<double>", hidden_layer_size,
+                                         entity, registry);
+    run<float, neural::sigmoid<float>>(format, "NeuralEngine<float>", hidden_layer_size,
+                                       entity, registry);
+    run<double, neural::tabulated_sigmoid<double>>(format, "NeuralEngine<double, tabulated_sigmoid>",
+                                                   hidden_layer_size, entity, registry);
+    run<float, neural::tabulated_sigmoid<float>>(format, "NeuralEngine<float, tabulated_sigmoid>",
+                                                 hidden_layer_size, entity, registry);
+  }
+
+  return 0;
+}
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <cmath>
+#include <concepts>
+#include <filesystem>
 #include <functional>
+#include <stdexcept>
+#include <span>
 #include <utility>
+#include <vector>
 
 #include <entt/entt.hpp>
 
@@ -10,23 +16,59 @@
 #include "ltl/Range/enumerate.h"
 #include "ltl/Tuple.h"
 
+#include "../../neural/activation.hpp"
 #include "../../neural/net.hpp"
+#include "../../neural/serialization.hpp"
 #include "../../neural/static_perceptron.hpp"
 #include "../component.hpp"
+#include "../feature_extraction.hpp"
 #include "../math.hpp"
 #include "../trial_parameters.hpp"
 
-double relu(double x) { return std::max(x, 0.0); }
-double sigmoid(double x) { return 1 / (1 + std::exp(-x)); }
-
 using FetcherType = double(entt::entity, entt::registry&);
 
+/*******************************************************************************
+  NeuralEngine est paramétré par le type des poids du réseau interne. Les
+  fetchers continuent de fournir des 'double' : leurs valeurs sont converties
+  vers 'Scalar' à l'entrée du réseau, ce qui permet de faire tourner l'inférence
+  en simple précision sans toucher au reste de la simulation.
+
+  La fonction d'activation de la couche de sortie peut être remplacée, par
+  exemple par 'neural::tabulated_sigmoid<Scalar>' qui évite un appel à
+  'std::exp' par neurone de sortie.
+
+  Plutôt que des fetchers, un NeuralEngine peut déclarer une liste de
+  caractéristiques ('Feature') : elles sont alors calculées une fois par pas
+  pour tous les robots de l'épreuve (voir 'feature_extraction.hpp'), et
+  l'entrée du réseau est lue dans la colonne du robot.
+*******************************************************************************/
+
+template<std::floating_point Scalar = double, auto& OutputActivation = neural::sigmoid<Scalar>>
 class NeuralEngine {
+  template<std::floating_point, auto&> friend class NeuralEngine;
+
+  using Network = neural::Net<
+    neural::StaticPerceptron<Scalar, neural::relu<Scalar>, true>,
+    neural::StaticPerceptron<Scalar, OutputActivation, true>
+  >;
+
 public:
-  std::ranges::range auto view() {
-    using Matrix = decltype(net[0_n].weights);
-    return std::array {net[0_n].weights.reshaped(), net[1_n].weights.reshaped()}
-        | ltl::join;
+  // Accéder aux poids du réseau interne, stockés de manière contiguë. Les poids
+  // d'un réseau projeté en mémoire (voir 'map') ne sont pas dans un tampon
+  // contigu : ils ne peuvent pas être parcourus ainsi.
+  std::span<Scalar> view() {
+    if (net.parameters().empty())
+      throw std::logic_error("The weights of a mapped NeuralEngine cannot be viewed");
+    return net.parameters();
+  }
+
+  // Accéder aux poids du réseau interne neurone par neurone, pour les croiser
+  // avec 'genetics::crossover_blocks'. Les poids d'un réseau projeté en mémoire
+  // sont ceux du fichier : ils ne peuvent pas être modifiés ainsi.
+  std::vector<std::span<Scalar>> neurons() {
+    if (net.parameters().empty())
+      throw std::logic_error("The weights of a mapped NeuralEngine cannot be modified");
+    return net.neurons();
   }
 
   static constexpr auto output_size = 3;
@@ -34,29 +76,108 @@ public:
   template<typename... Args>
   NeuralEngine(int hidden_layer_size, Args&&... fetchers)
     : net {(int) sizeof...(Args), hidden_layer_size, output_size},
-      fetchers {std::forward<Args>(fetchers)...} {}
+      fetchers {std::forward<Args>(fetchers)...}
+  {
+    net.flatten();
+  }
+
+  NeuralEngine(int hidden_layer_size, std::vector<Feature> features)
+    : net {(int) features.size(), hidden_layer_size, output_size},
+      features {std::move(features)}
+  {
+    net.flatten();
+  }
 
-  Setpoint operator()(entt::entity entity, entt::registry& registry) {
-    using Vector = neural::Vector<double>;
-    Vector input(fetchers.size());
-    for (auto&& [i, fetcher] : ltl::enumerate(fetchers))
-      input[i] = fetcher(entity, registry);
+  // Convertir un NeuralEngine d'une autre précision ou d'une autre fonction
+  // d'activation de sortie (les poids sont arrondis si besoin). Les poids sont
+  // copiés couche par couche, ce qui convient aussi à un réseau projeté en
+  // mémoire.
+  template<std::floating_point OtherScalar, auto& OtherActivation>
+  explicit NeuralEngine(const NeuralEngine<OtherScalar, OtherActivation>& other)
+    : net {other.net[0_n].input_size(), other.net[0_n].output_size(), output_size},
+      fetchers {other.fetchers},
+      features {other.features}
+  {
+    net.flatten();
+    auto cast = [](auto weight) { return static_cast<Scalar>(weight); };
+    std::ranges::transform(other.net[0_n].parameters.view(), net[0_n].parameters.data(), cast);
+    std::ranges::transform(other.net[1_n].parameters.view(), net[1_n].parameters.data(), cast);
+  }
 
-    auto output = net << input;
+  // Sauvegarder le réseau interne (les fetchers ne sont pas sauvegardés)
+  void save(const std::filesystem::path& path) const {
+    neural::save(net, path);
+  }
+
+  // Recharger le réseau interne depuis un fichier
+  void load(const std::filesystem::path& path) {
+    use(neural::load<Network>(path));
+  }
+
+  // Utiliser directement les poids d'un fichier projeté en mémoire. Le fichier
+  // doit survivre au NeuralEngine et à ses copies.
+  void map(neural::MappedFile& file) {
+    use(neural::map_net<Network>(file));
+  }
+
+  // Mémoire de travail d'une décision : l'entrée du réseau et la sortie de
+  // chacune de ses couches
+  struct Workspace {
+    neural::Vector<Scalar>      input;
+    typename Network::Workspace net;
+  };
+
+  //
+  Workspace make_workspace() const {
+    return {neural::Vector<Scalar>(net[0_n].input_size()), net.make_workspace()};
+  }
+
+  // Caractéristiques à extraire pour ce NeuralEngine (aucune s'il utilise des
+  // fetchers)
+  const std::vector<Feature>& get_features() const {
+    return features;
+  }
+
+  // Donner une consigne sans modifier le NeuralEngine ni allouer de mémoire. Un
+  // même NeuralEngine peut ainsi être utilisé par plusieurs épreuves en
+  // parallèle, chacune avec sa propre mémoire de travail.
+  Setpoint decide(entt::entity entity, entt::registry& registry, Workspace& workspace) const {
+    if (features.empty()) {
+      for (auto&& [i, fetcher] : ltl::enumerate(fetchers))
+        workspace.input[i] = static_cast<Scalar>(fetcher(entity, registry));
+    } else {
+      const auto& feature_matrix = registry.ctx<FeatureMatrix>();
+      auto        column = registry.get<FeatureColumn>(entity).index;
+      for (auto&& [i, feature] : ltl::enumerate(features))
+        workspace.input[i] = static_cast<Scalar>(feature_matrix(feature, column));
+    }
+
+    const auto& output = net.propagate(workspace.input, workspace.net);
     auto move = output[0];
     auto turn_left = output[1];
     auto turn_right = output[2];
 
     return Setpoint {
-      .speed = 2.0_q_m_per_s * std::min(move, 0.5),
+      .speed = 2.0_q_m_per_s * std::min(move, Scalar(0.5)),
       .angular_speed = 6.0_q_rad_per_s * (turn_right - turn_left)
     };
+  }
+
+  Setpoint operator()(entt::entity entity, entt::registry& registry) const {
+    auto workspace = make_workspace();
+    return decide(entity, registry, workspace);
   };
 
 private:
-  neural::Net<
-    neural::StaticPerceptron<double, relu>,
-    neural::StaticPerceptron<double, sigmoid>
-  > net;
+  //
+  void use(Network&& new_net) {
+    if (new_net[0_n].input_size() != net[0_n].input_size()
+     || new_net[1_n].output_size() != output_size)
+      throw std::runtime_error("Network does not match the fetchers of the NeuralEngine");
+    net = std::move(new_net);
+  }
+
+  Network net;
   std::list<std::function<FetcherType>> fetchers;
+  std::vector<Feature>                  features;
 };
@@ -1,14 +1,19 @@
 #include <catch.hpp>
 #include "../neural_engine.hpp"
 
+#include <filesystem>
 #include <iterator>
 #include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include <SFML/Graphics.hpp>
 
 #include "../../../genetics/genetics.hpp"
 #include "../../../seed.hpp"
 #include "../../entity/robot_features.hpp"
+#include "../../trial.hpp"
 
 Setpoint dont_move(entt::entity, entt::registry&) {
   return { .speed = 0_q_m_per_s, .angular_speed = 0_q_rad_per_s };
@@ -18,6 +23,21 @@ double fetch_nothing(entt::entity, entt::registry&) {
   return 0.0;
 }
 
+double sin_to_goal(entt::entity entity, entt::registry& registry) {
+  const auto& goal = get_goal(entity, registry);
+  return sin(atan(goal - registry.get<Position>(entity)) - registry.get<Kinematics>(entity).direction);
+}
+
+double cos_to_goal(entt::entity entity, entt::registry& registry) {
+  const auto& goal = get_goal(entity, registry);
+  return cos(atan(goal - registry.get<Position>(entity)) - registry.get<Kinematics>(entity).direction);
+}
+
+double distance_to_goal(entt::entity entity, entt::registry& registry) {
+  const auto& goal = get_goal(entity, registry);
+  return norm2(goal - registry.get<Position>(entity)).count();
+}
+
 TEST_CASE("NeuralEngine : donner une consigne en fonction de l'environement") {
   RobotFeatures robot_features {
     .hitbox { 5_q_cm },
@@ -71,7 +91,7 @@ TEST_CASE("NeuralEngine : itérer les poids") {
     NeuralEngine neural_engine(10, fetch_nothing);
     auto weights = neural_engine.view();
 
-    REQUIRE(std::distance(weights.begin(), weights.end()) == 1 * 10 + 10 * 3);
+    REQUIRE(std::distance(weights.begin(), weights.end()) == (1 + 1) * 10 + (10 + 1) * 3);
   }
 }
 
@@ -81,7 +101,7 @@ TEST_CASE("NeuralEngine : entraîner le réseau interne") {
     NeuralEngine neural_engine(10, fetch_nothing);
     genetics::mutate(neural_engine.view(), 0.5, [&](auto& x, const auto&) { x = 0; });
 
-    CHECK(std::abs(ltl::count(neural_engine.view(), 0) - 40) <= 15);
+    CHECK(std::abs(ltl::count(neural_engine.view(), 0) - 53) <= 15);
   }
 
   SECTION("NeuralEngine est compatible avec genetics::crossover_uniform, ce qui "
@@ -91,7 +111,206 @@ TEST_CASE("NeuralEngine : entraîner le réseau interne") {
     for (auto& weight : neural_engine2.view()) weight = 1;
     genetics::crossover_uniform(neural_engine1.view(), neural_engine2.view());
 
-    REQUIRE(ltl::count(neural_engine1.view(), 0) + ltl::count(neural_engine2.view(), 0) == 40);
-    REQUIRE(ltl::count(neural_engine1.view(), 1) + ltl::count(neural_engine2.view(), 1) == 40);
+    REQUIRE(ltl::count(neural_engine1.view(), 0) + ltl::count(neural_engine2.view(), 0) == 53);
+    REQUIRE(ltl::count(neural_engine1.view(), 1) + ltl::count(neural_engine2.view(), 1) == 53);
+  }
+
+  SECTION("NeuralEngine est compatible avec genetics::crossover_blocks, ce qui "
+          "permet de croiser les neurones entiers de deux instances de "
+          "NeuralEngine") {
+    NeuralEngine neural_engine1(10, fetch_nothing), neural_engine2(10, fetch_nothing);
+    for (auto& weight : neural_engine1.view()) weight = 0;
+    for (auto& weight : neural_engine2.view()) weight = 1;
+    auto neurons = neural_engine1.neurons();
+    genetics::crossover_blocks(neurons, neural_engine2.neurons());
+
+    REQUIRE(neurons.size() == 10 + 3);
+    for (const auto& neuron : neurons)
+      REQUIRE(ltl::count(neuron, neuron[0]) == (int) neuron.size());
+    REQUIRE(ltl::count(neural_engine1.view(), 0) + ltl::count(neural_engine2.view(), 0) == 53);
+  }
+}
+
+// NeuralEngine aux poids aléatoires, toujours les mêmes
+NeuralEngine<double> make_random_engine() {
+  std::mt19937             rnd_engine(1337);
+  std::normal_distribution make_noise(0.0, 1.0);
+
+  NeuralEngine<double> neural_engine(15, sin_to_goal, cos_to_goal, distance_to_goal);
+  genetics::mutate(neural_engine.view(), 1.0, [&](auto& x, auto&) { x = make_noise(rnd_engine); });
+  return neural_engine;
+}
+
+// Vérifier que deux NeuralEngine donnent les mêmes consignes, à 'tolerance'
+// près, à des robots placés aléatoirement
+void require_same_decisions(const auto& expected_engine, const auto& neural_engine,
+                            double speed_tolerance, double angular_speed_tolerance) {
+  RobotFeatures robot_features {
+    .hitbox { 10_q_cm },
+    .strategy_ftor = dont_move,
+    .shape = sf::CircleShape(0),
+    .goal_mark_shape = sf::CircleShape(0)
+  };
+  TrialContext trial_context;
+  auto& registry = trial_context.prepare({
+    .playground {0_q_m, 0_q_m, 5_q_m, 5_q_m },
+    .foe_nb = 0,
+    .seed = 42,
+    .dt = 0.1_q_s,
+    .time_limit = 10_q_s
+  });
+
+  for (int i = 0; i < 1000; i++) {
+    auto robot = create_robot(registry, robot_features, false);
+    auto expected = expected_engine(robot, registry);
+    auto setpoint = neural_engine(robot, registry);
+    REQUIRE(setpoint.speed.count() == Approx(expected.speed.count()).margin(speed_tolerance));
+    REQUIRE(setpoint.angular_speed.count()
+         == Approx(expected.angular_speed.count()).margin(angular_speed_tolerance));
+  }
+}
+
+TEST_CASE("NeuralEngine : convertir un NeuralEngine vers une autre précision ou "
+          "une autre activation de sortie") {
+  auto double_engine = make_random_engine();
+
+  SECTION("Un NeuralEngine converti en simple précision donne les mêmes "
+          "consignes qu'en double précision, aux arrondis près") {
+    NeuralEngine<float> float_engine(double_engine);
+    require_same_decisions(double_engine, float_engine, 1e-4, 1e-4);
+  }
+
+  SECTION("Un NeuralEngine utilisant 'tabulated_sigmoid' donne les mêmes "
+          "consignes qu'avec la sigmoïde exacte, à l'erreur de la table près") {
+    // Erreur maximale de 'tabulated_sigmoid' (voir 'activation.hpp'), multipliée
+    // par les facteurs des consignes
+    constexpr double sigmoid_error = 2e-5;
+    NeuralEngine<double, neural::tabulated_sigmoid<double>> tabulated_engine(double_engine);
+    require_same_decisions(double_engine, tabulated_engine, 2 * sigmoid_error, 2 * 6 * sigmoid_error);
+  }
+
+  SECTION("Un NeuralEngine projeté en mémoire peut être converti, mais ses poids "
+          "ne peuvent pas être parcourus par 'view' ni par 'neurons'") {
+    auto path = std::filesystem::temp_directory_path() / "ut_neural_engine.nn";
+    double_engine.save(path);
+    neural::MappedFile file(path);
+    NeuralEngine<double> mapped_engine(15, sin_to_goal, cos_to_goal, distance_to_goal);
+    mapped_engine.map(file);
+
+    REQUIRE_THROWS_AS(mapped_engine.view(), std::logic_error);
+    REQUIRE_THROWS_AS(mapped_engine.neurons(), std::logic_error);
+    NeuralEngine<float> float_engine(mapped_engine);
+    require_same_decisions(double_engine, mapped_engine, 0, 0);
+    require_same_decisions(double_engine, float_engine, 1e-4, 1e-4);
+
+    std::filesystem::remove(path);
+  }
+}
+
+TEST_CASE("NeuralEngine : partager un NeuralEngine entre plusieurs threads") {
+  std::mt19937             rnd_engine(1337);
+  std::normal_distribution make_noise(0.0, 1.0);
+
+  const auto neural_engine = [&] {
+    NeuralEngine neural_engine(15, sin_to_goal, cos_to_goal, distance_to_goal);
+    genetics::mutate(neural_engine.view(), 1.0, [&](auto& x, auto&) { x = make_noise(rnd_engine); });
+    return neural_engine;
+  }();
+  RobotFeatures robot_features {
+    .hitbox { 10_q_cm },
+    .strategy_ftor = dont_move,
+    .shape = sf::CircleShape(0),
+    .goal_mark_shape = sf::CircleShape(0)
+  };
+  auto make_registry = [&](int64_t seed) {
+    auto registry = std::make_unique<entt::registry>();
+    registry->set<std::mt19937>(seed);
+    registry->set<TrialParameters>(
+      TrialParameters {
+        .playground {0_q_m, 0_q_m, 5_q_m, 5_q_m },
+        .foe_nb = 0,
+        .seed = seed,
+        .dt = 0.1_q_s,
+        .time_limit = 10_q_s
+      });
+    return registry;
+  };
+
+  SECTION("Avec une mémoire de travail par thread, 'decide' donne les mêmes "
+          "consignes que l'opérateur () appelé séquentiellement") {
+    std::vector<int>         errors_nb(8, 0);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < 8; i++) {
+      threads.emplace_back([&, i] {
+        auto registry = make_registry(i);
+        auto workspace = neural_engine.make_workspace();
+        for (int j = 0; j < 100; j++) {
+          auto robot = create_robot(*registry, robot_features, false);
+          auto setpoint = neural_engine.decide(robot, *registry, workspace);
+          auto expected = neural_engine(robot, *registry);
+          errors_nb[i] += setpoint.speed != expected.speed
+                       || setpoint.angular_speed != expected.angular_speed;
+        }
+      });
+    }
+    for (auto& thread : threads) thread.join();
+
+    REQUIRE(std::count(errors_nb.begin(), errors_nb.end(), 0) == 8);
+  }
+}
+
+TEST_CASE("NeuralEngine : lire les caractéristiques extraites une fois par pas") {
+  std::mt19937             rnd_engine(1337);
+  std::normal_distribution make_noise(0.0, 1.0);
+
+  NeuralEngine fetching_engine(15, sin_to_goal, cos_to_goal, distance_to_goal);
+  genetics::mutate(fetching_engine.view(), 1.0, [&](auto& x, auto&) { x = make_noise(rnd_engine); });
+  NeuralEngine extracting_engine(15, {Feature::sin_to_goal, Feature::cos_to_goal,
+                                      Feature::distance_to_goal});
+  std::ranges::copy(fetching_engine.view(), extracting_engine.view().begin());
+
+  RobotFeatures robot_features {
+    .hitbox { 10_q_cm },
+    .strategy_ftor = dont_move,
+    .shape = sf::CircleShape(0),
+    .goal_mark_shape = sf::CircleShape(0)
+  };
+  TrialContext trial_context;
+  auto& registry = trial_context.prepare({
+    .playground {0_q_m, 0_q_m, 5_q_m, 5_q_m },
+    .foe_nb = 0,
+    .seed = 1337,
+    .dt = 0.1_q_s,
+    .time_limit = 10_q_s
+  });
+  std::vector<entt::entity> robots;
+  for (int i = 0; i < 10; i++) robots.push_back(create_robot(registry, robot_features, false));
+
+  auto& feature_matrix = registry.ctx_or_set<FeatureMatrix>();
+  declare_features(feature_matrix, extracting_engine);
+  declare_features(feature_matrix, fetching_engine);
+  extract_features(registry);
+
+  SECTION("Les caractéristiques extraites ont les valeurs données par les "
+          "fetchers équivalents, une colonne par robot") {
+    REQUIRE(feature_matrix.get_features().size() == 3);
+    REQUIRE(feature_matrix.get_values().cols() == 10);
+    for (auto robot : robots) {
+      auto column = feature_matrix.column(robot, registry);
+      REQUIRE(column[0] == Approx(sin_to_goal(robot, registry)));
+      REQUIRE(column[1] == Approx(cos_to_goal(robot, registry)));
+      REQUIRE(column[2] == Approx(distance_to_goal(robot, registry)));
+    }
+  }
+
+  SECTION("Un NeuralEngine utilisant les caractéristiques extraites donne les "
+          "mêmes consignes qu'avec les fetchers équivalents") {
+    for (auto robot : robots) {
+      auto setpoint = extracting_engine(robot, registry);
+      auto expected = fetching_engine(robot, registry);
+      REQUIRE(setpoint.speed.count() == Approx(expected.speed.count()));
+      REQUIRE(setpoint.angular_speed.count() == Approx(expected.angular_speed.count()));
+    }
   }
 }
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "component.hpp"
+#include "physics.hpp"
+#include "trial_parameters.hpp"
+
+/*******************************************************************************
+  SweepAndPrune détecte tous les contacts entre robots, et non seulement ceux
+  du candidat. Chaque robot est projeté sur l'axe x en un intervalle
+  [x - rayon, x + rayon] ; seules les paires dont les intervalles se
+  chevauchent sont testées. Les intervalles sont conservés d'un pas à l'autre,
+  triés par borne inférieure : les robots se déplaçant peu en un pas, l'ordre
+  change peu et un tri par insertion le rétablit en un temps presque linéaire.
+
+  La détection est continue : l'intervalle d'un robot couvre tout son
+  déplacement pendant le pas, et une paire est en contact si les robots se
+  touchent à un instant quelconque du pas (voir 'Hitbox::get_impact_fraction').
+  Deux robots rapides ne peuvent donc pas se traverser, même avec un grand pas
+  de temps.
+
+  Les contacts du pas sont écrits dans un tableau réutilisé, trié par paire
+  d'entités, que les systèmes ('detect_collisions') et les mesures ('step_trial')
+  lisent sans parcourir le registre. Un contact porte l'instant où il a
+  commencé : un contact qui dure plusieurs pas garde le même instant.
+*******************************************************************************/
+
+struct Contact {
+  entt::entity  first;  // first < second
+  entt::entity  second;
+  physics::time time;   // Début du contact (instant de l'impact)
+};
+
+class SweepAndPrune {
+public:
+  // Oublier les contacts de l'épreuve précédente et prendre les positions des
+  // robots de la nouvelle épreuve comme positions de départ
+  void reset(entt::registry& registry) {
+    time = physics::time(0);
+    intervals.clear();
+    contacts.clear();
+    previous_contacts.clear();
+    new_contacts_nb = 0;
+    update_intervals(registry);
+  }
+
+  // Trouver les contacts à la fin d'un pas de temps
+  void update(entt::registry& registry) {
+    dt = registry.ctx<TrialParameters>().dt;
+    time += dt;
+    update_intervals(registry);
+    sweep();
+  }
+
+  //
+  const std::vector<Contact>& get_contacts() const { return contacts; }
+  size_t get_new_contacts_nb() const { return new_contacts_nb; }
+  physics::time get_time() const { return time; }
+
+private:
+  struct Interval {
+    entt::entity    entity;
+    physics::length min_x, max_x;
+    Position        start;    // Position au début du pas
+    Position        position; // Position à la fin du pas
+    Hitbox          hitbox;
+  };
+
+  //
+  static Interval make_interval(entt::entity entity, const Position& start,
+                                const Position& position, const Hitbox& hitbox) {
+    return {
+      entity,
+      std::min(start.x, position.x) - hitbox.radius,
+      std::max(start.x, position.x) + hitbox.radius,
+      start, position, hitbox
+    };
+  }
+
+  // Mettre à jour les intervalles puis rétablir leur ordre. La position de fin
+  // du pas précédent devient la position de début du pas. Les intervalles ne
+  // sont reconstruits que si des robots ont été créés ou détruits ; les robots
+  // sont alors considérés comme immobiles pendant le pas.
+  void update_intervals(entt::registry& registry) {
+    auto group = bodies(registry);
+    bool is_stale = intervals.size() != group.size();
+    for (auto& interval : intervals) {
+      if (is_stale || !registry.valid(interval.entity) || !group.contains(interval.entity)) {
+        is_stale = true;
+        break;
+      }
+      auto&& [position, hitbox] = group.get<Position, Hitbox>(interval.entity);
+      interval = make_interval(interval.entity, interval.position, position, hitbox);
+    }
+
+    auto compare = [](const Interval& lhs, const Interval& rhs) { return lhs.min_x < rhs.min_x; };
+    if (is_stale) {
+      intervals.clear();
+      for (auto&& [entity, position, kinematics, hitbox] : group.each())
+        intervals.push_back(make_interval(entity, position, position, hitbox));
+      std::ranges::sort(intervals, compare);
+      return;
+    }
+
+    for (size_t i = 1; i < intervals.size(); i++) {
+      auto   interval = intervals[i];
+      size_t j = i;
+      for (; j > 0 && compare(interval, intervals[j - 1]); j--) intervals[j] = intervals[j - 1];
+      intervals[j] = interval;
+    }
+  }
+
+  // Tester les paires dont les intervalles se chevauchent, puis reprendre
+  // l'instant de début des contacts qui existaient déjà au pas précédent
+  void sweep() {
+    std::swap(contacts, previous_contacts);
+    contacts.clear();
+    for (size_t i = 0; i < intervals.size(); i++) {
+      const auto& lhs = intervals[i];
+      for (size_t j = i + 1; j < intervals.size() && intervals[j].min_x < lhs.max_x; j++) {
+        const auto& rhs = intervals[j];
+        auto fraction = lhs.hitbox.get_impact_fraction(rhs.hitbox, rhs.start - lhs.start,
+                                                       rhs.position - lhs.position);
+        if (fraction)
+          contacts.push_back({
+            std::min(lhs.entity, rhs.entity),
+            std::max(lhs.entity, rhs.entity),
+            time - (1 - *fraction) * dt
+          });
+      }
+    }
+
+    auto compare = [](const Contact& lhs, const Contact& rhs) {
+      return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second);
+    };
+    std::ranges::sort(contacts, compare);
+
+    new_contacts_nb = contacts.size();
+    auto previous = previous_contacts.begin();
+    for (auto& contact : contacts) {
+      while (previous != previous_contacts.end() && compare(*previous, contact)) ++previous;
+      if (previous != previous_contacts.end() && !compare(contact, *previous)) {
+        contact.time = previous->time;
+        new_contacts_nb--;
+      }
+    }
+  }
+
+  physics::time         time {0};
+  physics::time         dt {0};
+  std::vector<Interval> intervals;
+  std::vector<Contact>  contacts;
+  std::vector<Contact>  previous_contacts;
+  size_t                new_contacts_nb = 0;
+};
+
+// Trouver les contacts entre robots après leur déplacement
+void update_contacts(entt::registry& registry) {
+  registry.ctx_or_set<SweepAndPrune>().update(registry);
+}
@@ -6,79 +6,150 @@
 
 #include "ltl/Range/Map.h"
 
+#ifndef GATE_HEADLESS
 #include <SFML/Graphics.hpp>
+#endif
 
 #include <units/random.h>
 
 #include "../seed.hpp"
 #include "component/hitbox.hpp"
 #include "entity/robot_features.hpp"
+#ifndef GATE_HEADLESS
 #include "io/event.hpp"
 #include "io/render.hpp"
+#endif
 #include "mechanic.hpp"
 #include "outcome.hpp"
 #include "physics.hpp"
+#include "trial_context.hpp"
 #include "trial_results.hpp"
 
+/*******************************************************************************
+  'perform_trial' simule une épreuve sans affichage : aucun objet SFML n'est
+  construit et les systèmes d'affichage ne sont pas exécutés. C'est la seule
+  version disponible lorsque GATE_HEADLESS est défini, ce qui permet de
+  compiler un binaire d'entraînement sans le lier à SFML (voir la cible
+  'train'). Sinon, 'perform_trial' peut aussi afficher l'épreuve en temps réel.
+
+  Sans affichage, le registre n'est pas reconstruit à chaque épreuve : il est
+  fourni par un TrialContext (par défaut, celui du thread appelant).
+*******************************************************************************/
+
+// Créer le candidat et les adversaires en tant qu'entité. La variable de contexte
+// associée au type 'entt::entity' dans le registre vaut l'identifiant du candidat.
+entt::entity populate_trial(TrialContext& trial_context,
+                            const TrialParameters& trial_parameters,
+                            const RobotFeatures<auto, auto, auto>& candidate_features,
+                            const RobotFeatures<auto, auto, auto>& foe_features,
+                            bool shall_display) {
+  auto& registry = trial_context.prepare(trial_parameters);
+
+  // Déclarer les caractéristiques que les stratégies lisent à chaque pas
+  auto& feature_matrix = registry.ctx_or_set<FeatureMatrix>();
+  feature_matrix.reset();
+  declare_features(feature_matrix, candidate_features.strategy_ftor);
+  declare_features(feature_matrix, foe_features.strategy_ftor);
+
+  // Les adversaires partagent la même stratégie, qui n'est stockée que s'il y a
+  // des adversaires
+  auto candidate = create_robot(registry, candidate_features, shall_display);
+  if (trial_parameters.foe_nb > 0) {
+    auto foe_strategy = add_strategy(registry, foe_features.strategy_ftor);
+    for (size_t i = 0; i < trial_parameters.foe_nb; i++)
+      create_robot(registry, foe_features, shall_display, foe_strategy);
+  }
+  registry.ctx_or_set<entt::entity>(candidate) = candidate;
+  registry.ctx_or_set<SweepAndPrune>().reset(registry);
+
+  return candidate;
+}
+
+// Vérifier que l'épreuve n'est pas terminée
+bool is_running(const entt::registry& registry, const TrialResults& results) {
+  return registry.ctx<Outcome>() == Outcome::none
+      && results.time < registry.ctx<TrialParameters>().time_limit;
+}
+
+// Faire avancer l'épreuve d'un pas de temps et mettre à jour ses résultats
+void step_trial(entt::registry& registry, entt::entity candidate, TrialResults& results) {
+  update_trial(registry);
+
+  auto distance = get_distance_to_goal(candidate, registry);
+  if (distance < results.best_distance) results.best_distance = distance;
+
+  results.time += registry.ctx<TrialParameters>().dt;
+  results.outcome = registry.ctx<Outcome>();
+  results.contacts_nb += registry.ctx<SweepAndPrune>().get_new_contacts_nb();
+}
+
+// Mener une épreuve dans le registre de 'trial_context', qui est réutilisé
+TrialResults perform_trial(TrialContext& trial_context,
+                           const TrialParameters& trial_parameters,
+                           const RobotFeatures<auto, auto, auto>& candidate_features,
+                           const RobotFeatures<auto, auto, auto>& foe_features) {
+  auto  candidate = populate_trial(trial_context, trial_parameters, candidate_features,
+                                   foe_features, false);
+  auto& registry = trial_context.get_registry();
+
+  TrialResults results {
+    .outcome = Outcome::none,
+    .time = 0_q_ms,
+    .best_distance = get_distance_to_goal(candidate, registry)
+  };
+  while (is_running(registry, results)) step_trial(registry, candidate, results);
+
+  return results;
+}
+
+// Mener une épreuve dans le registre propre au thread appelant
+TrialResults perform_trial(const TrialParameters& trial_parameters,
+                           const RobotFeatures<auto, auto, auto>& candidate_features,
+                           const RobotFeatures<auto, auto, auto>& foe_features) {
+  return perform_trial(local_trial_context(), trial_parameters, candidate_features,
+                       foe_features);
+}
+
+#ifndef GATE_HEADLESS
+//
 TrialResults perform_trial(const TrialParameters& trial_parameters,
                            const RobotFeatures<auto, auto, auto>& candidate_features,
                            const RobotFeatures<auto, auto, auto>& foe_features,
-                           bool shall_display = false) {
-  entt::registry registry;
-  registry.set<TrialParameters>(trial_parameters);
-  registry.set<Outcome>(Outcome::none);
-  registry.set<std::mt19937>(trial_parameters.seed);
-
-  // Créer le candidat et les adversaires en tant qu'entité. La variable de contexte
-  // associée au type 'entt::entity' dans le registre vaut l'identifiant du candidat.
-  auto candidate = create_robot(registry, candidate_features, shall_display);
-  for (auto i = 0; i < trial_parameters.foe_nb; i++)
-    create_robot(registry, foe_features, shall_display);
-  registry.set<entt::entity>(candidate);
+                           bool shall_display) {
+  if (!shall_display) return perform_trial(trial_parameters, candidate_features, foe_features);
 
-  // Créer un fenêtre de rendu et le sprite de la zone de jeu si nécessaire.
-  sf::RenderWindow render_window;
-  if (shall_display) {
-    auto center = create_playground_sprite(registry);
-    render_window.create(sf::VideoMode::getDesktopMode(), "Unit test");
+  TrialContext trial_context;
+  auto  candidate = populate_trial(trial_context, trial_parameters, candidate_features,
+                                   foe_features, true);
+  auto& registry = trial_context.get_registry();
 
-    auto view = render_window.getView();
-    view.setCenter(center);
-    render_window.setView(view);
+  // Créer un fenêtre de rendu et le sprite de la zone de jeu
+  sf::RenderWindow render_window;
+  auto center = create_playground_sprite(registry);
+  render_window.create(sf::VideoMode::getDesktopMode(), "Unit test");
 
-  } else {
-    create_playground_sprite(registry);
-  }
+  auto view = render_window.getView();
+  view.setCenter(center);
+  render_window.setView(view);
 
-  physics::time   simulation_time = 0_q_ms;
-  physics::length best_distance = get_distance_to_goal(candidate, registry);
-  sf::Clock       clock;
-  while (registry.ctx<Outcome>() == Outcome::none
-     && (!shall_display || render_window.isOpen())
-     && (simulation_time < trial_parameters.time_limit)) {
-    set_setpoints(registry);
-    update_positions(registry);
+  TrialResults results {
+    .outcome = Outcome::none,
+    .time = 0_q_ms,
+    .best_distance = get_distance_to_goal(candidate, registry)
+  };
+  sf::Clock clock;
+  while (is_running(registry, results) && render_window.isOpen()) {
+    step_trial(registry, candidate, results);
     position_sprites(registry);
     rotate_sprites(registry);
-    update_tasks(registry);
-    detect_collisions(registry);
 
-    if (shall_display) {
-      display(render_window, registry);
-      handle_events(render_window);
-    }
+    display(render_window, registry);
+    handle_events(render_window);
 
-    auto distance = get_distance_to_goal(candidate, registry);
-    if (distance < best_distance) best_distance = distance;
-
-    simulation_time += trial_parameters.dt;
-    while (shall_display && clock.getElapsedTime().asMilliseconds() < quantity_cast<si::millisecond>(trial_parameters.dt).count());
+    while (clock.getElapsedTime().asMilliseconds() < quantity_cast<si::millisecond>(trial_parameters.dt).count());
     clock.restart();
   }
 
-  return {
-    .outcome = registry.ctx<Outcome>(),
-    .time = simulation_time,
-    .best_distance = best_distance
-  };
+  return results;
 }
+#endif
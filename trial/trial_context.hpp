@@ -0,0 +1,46 @@
+#pragma once
+
+#include <random>
+
+#include <entt/entt.hpp>
+
+#include "component/strategy.hpp"
+#include "outcome.hpp"
+#include "trial_parameters.hpp"
+
+/*******************************************************************************
+  TrialContext conserve le registre d'une épreuve à l'autre. Construire un
+  registre, ses variables de contexte (dont un 'std::mt19937' d'environ 5 Kio)
+  et le stockage de chaque composant coûte plus cher qu'une épreuve courte :
+  'prepare' vide le registre sans libérer le stockage des composants, puis met à
+  jour les variables de contexte en place et ré-initialise le générateur avec la
+  graine de l'épreuve. Les stratégies de l'épreuve précédente sont oubliées.
+
+  Un registre ne pouvant être utilisé que par une épreuve à la fois,
+  'local_trial_context' fournit un TrialContext par thread.
+*******************************************************************************/
+
+class TrialContext {
+public:
+  // Préparer le registre pour une nouvelle épreuve
+  entt::registry& prepare(const TrialParameters& trial_parameters) {
+    if (auto* dispatch = registry.try_ctx<StrategyDispatch>()) dispatch->clear(registry);
+    registry.clear();
+    registry.ctx_or_set<TrialParameters>(trial_parameters) = trial_parameters;
+    registry.ctx_or_set<Outcome>(Outcome::none) = Outcome::none;
+    registry.ctx_or_set<std::mt19937>().seed(trial_parameters.seed);
+    return registry;
+  }
+
+  //
+  entt::registry& get_registry() { return registry; }
+
+private:
+  entt::registry registry;
+};
+
+//
+inline TrialContext& local_trial_context() {
+  thread_local TrialContext trial_context;
+  return trial_context;
+}
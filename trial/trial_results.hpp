@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+
 #include "outcome.hpp"
 #include "physics.hpp"
 
@@ -7,4 +9,5 @@ struct TrialResults {
   Outcome         outcome;
   physics::time   time;
   physics::length best_distance;
+  size_t          contacts_nb = 0; // Contacts entre robots (pas calculé par BatchTrial)
 };
@@ -0,0 +1,96 @@
+#include <catch.hpp>
+#include "../batch_trial.hpp"
+
+#include <vector>
+
+#include "../trial.hpp"
+
+/*
+  Chaque stratégie existe en deux versions : l'une lit le registre d'une épreuve
+  menée par 'perform_trial', l'autre l'état d'un BatchTrial
+*/
+
+Setpoint go_straight(entt::entity, entt::registry&) {
+  return { .speed = 10_q_cm_per_s, .angular_speed = 0_q_rad_per_s };
+}
+
+Setpoint batch_go_straight(const BatchTrial&, size_t, size_t) {
+  return { .speed = 10_q_cm_per_s, .angular_speed = 0_q_rad_per_s };
+}
+
+Setpoint dont_move(entt::entity, entt::registry&) {
+  return { .speed = 0_q_m_per_s, .angular_speed = 0_q_rad_per_s };
+}
+
+Setpoint batch_dont_move(const BatchTrial&, size_t, size_t) {
+  return { .speed = 0_q_m_per_s, .angular_speed = 0_q_rad_per_s };
+}
+
+Setpoint steer(Position translation, physics::angle direction) {
+  auto delta = sin(atan(translation) - direction);
+  return {
+    .speed = 5_q_m_per_s / (1 + 10 * std::abs(delta)),
+    .angular_speed = std::signbit(delta) ? -2_q_rad_per_s : +2_q_rad_per_s
+  };
+}
+
+Setpoint seek_goal(entt::entity entity, entt::registry& registry) {
+  return steer(get_goal(entity, registry) - registry.get<Position>(entity),
+               registry.get<Kinematics>(entity).direction);
+}
+
+Setpoint batch_seek_goal(const BatchTrial& batch, size_t trial, size_t robot) {
+  return steer(batch.goal(trial, robot) - batch.position(trial, robot),
+               batch.get_direction(trial, robot));
+}
+
+RobotFeatures straight_features { .hitbox {10_q_cm}, .strategy_ftor = go_straight };
+RobotFeatures sleeper_features { .hitbox {10_q_cm}, .strategy_ftor = dont_move };
+RobotFeatures worker_features { .hitbox {10_q_cm}, .strategy_ftor = seek_goal };
+
+TEST_CASE("BatchTrial : mener plusieurs épreuves en même temps") {
+  TrialParameters trial_parameters {
+    .playground {0_q_m, 0_q_m, 5_q_m, 4_q_m},
+    .foe_nb = 3,
+    .seed = 0,
+    .dt = 10_q_ms,
+    .time_limit = 10_q_s
+  };
+  std::vector<int64_t> seeds {0, 1, 2, 3, 4, 5, 6, 7, 42, 1337};
+
+  SECTION("Chaque épreuve a la même issue que si elle était menée seule par "
+          "'perform_trial' avec la même graine") {
+    BatchTrial batch(trial_parameters, seeds, Hitbox{10_q_cm}, Hitbox{10_q_cm});
+    auto results = batch.run(batch_seek_goal, batch_dont_move);
+
+    REQUIRE(results.size() == seeds.size());
+    for (size_t i = 0; i < seeds.size(); i++) {
+      trial_parameters.seed = seeds[i];
+      auto expected = perform_trial(trial_parameters, worker_features, sleeper_features);
+      REQUIRE(results[i].outcome == expected.outcome);
+      REQUIRE(results[i].time.count() == Approx(expected.time.count()).epsilon(1e-3));
+      REQUIRE(results[i].best_distance.count()
+           == Approx(expected.best_distance.count()).margin(1e-3));
+    }
+  }
+
+  SECTION("Une épreuve terminée n'évolue plus pendant que les autres continuent") {
+    trial_parameters.time_limit = 1_q_s;
+    BatchTrial batch(trial_parameters, seeds, Hitbox{10_q_cm}, Hitbox{10_q_cm});
+    auto results = batch.run(batch_go_straight, batch_go_straight);
+
+    REQUIRE_FALSE(batch.is_running());
+    for (size_t i = 0; i < seeds.size(); i++) {
+      trial_parameters.seed = seeds[i];
+      auto expected = perform_trial(trial_parameters, straight_features, straight_features);
+      REQUIRE(results[i].outcome == expected.outcome);
+      REQUIRE(results[i].time <= trial_parameters.time_limit + trial_parameters.dt);
+    }
+  }
+
+  SECTION("Sans épreuve, BatchTrial ne fait rien") {
+    BatchTrial batch(trial_parameters, {}, Hitbox{10_q_cm}, Hitbox{10_q_cm});
+    REQUIRE_FALSE(batch.is_running());
+    REQUIRE(batch.run(batch_go_straight, batch_go_straight).empty());
+  }
+}
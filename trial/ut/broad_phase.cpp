@@ -0,0 +1,104 @@
+#include <catch.hpp>
+#include "../broad_phase.hpp"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "../feature_extraction.hpp"
+#include "../trial.hpp"
+
+Setpoint dont_move(entt::entity, entt::registry&) {
+  return { .speed = 0_q_m_per_s, .angular_speed = 0_q_rad_per_s };
+}
+
+// Robots dont le centre est à moins de 'range' de 'center', par un parcours de
+// tous les robots
+std::vector<entt::entity> find_near(entt::registry& registry, const Position& center,
+                                    physics::length range) {
+  std::vector<entt::entity> near;
+  for (auto&& [entity, position, kinematics, hitbox] : bodies(registry).each())
+    if (norm2(position - center) < range) near.push_back(entity);
+  std::ranges::sort(near);
+  return near;
+}
+
+TEST_CASE("BroadPhase : trouver les robots proches sans parcourir tous les robots") {
+  TrialContext trial_context;
+  auto& registry = trial_context.prepare({
+    .playground {-5_q_m, -5_q_m, 10_q_m, 10_q_m},
+    .foe_nb = 0,
+    .seed = 1337,
+    .dt = 0.1_q_s,
+    .time_limit = 10_q_s
+  });
+  RobotFeatures small_features { .hitbox {5_q_cm}, .strategy_ftor = dont_move };
+  RobotFeatures large_features { .hitbox {20_q_cm}, .strategy_ftor = dont_move };
+  for (int i = 0; i < 500; i++) create_robot(registry, i % 2 ? small_features : large_features, false);
+  update_broad_phase(registry);
+  const auto& broad_phase = registry.ctx<BroadPhase>();
+
+  std::mt19937 rnd_engine(42);
+  PositionPicker pick_position(registry.ctx<TrialParameters>().playground);
+
+  SECTION("La grille range tous les robots et sa cellule suit le plus grand Hitbox") {
+    REQUIRE(broad_phase.size() == 500);
+    REQUIRE(broad_phase.get_max_radius().count() == Approx(0.2));
+  }
+
+  SECTION("Une requête donne les mêmes robots qu'un parcours de tous les robots, "
+          "chacun une seule fois, quelle que soit la portée") {
+    physics::length ranges[] = {10_q_cm, 40_q_cm, 1_q_m, 20_q_m};
+    for (auto range : ranges) {
+      for (int i = 0; i < 50; i++) {
+        auto center = pick_position(rnd_engine);
+        std::vector<entt::entity> near;
+        broad_phase.for_each_near(center, range,
+                                  [&](const auto& body) { near.push_back(body.entity); });
+        std::ranges::sort(near);
+        REQUIRE(near == find_near(registry, center, range));
+      }
+    }
+  }
+
+  SECTION("Une requête très loin de la zone de jeu, éventuellement de portée "
+          "immense, donne aussi les mêmes robots qu'un parcours de tous les robots") {
+    Position        far_center(physics::length(1e12), physics::length(-1e12));
+    physics::length ranges[] = {1_q_m, physics::length(1e13)};
+    for (auto range : ranges) {
+      std::vector<entt::entity> near;
+      broad_phase.for_each_near(far_center, range,
+                                [&](const auto& body) { near.push_back(body.entity); });
+      std::ranges::sort(near);
+      REQUIRE(near == find_near(registry, far_center, range));
+    }
+  }
+
+  SECTION("La distance au robot le plus proche est celle donnée par un parcours "
+          "de tous les robots, bornée par la portée des capteurs") {
+    auto& feature_matrix = registry.ctx_or_set<FeatureMatrix>();
+    feature_matrix.reset();
+    feature_matrix.declare({Feature::nearest_distance});
+    extract_features(registry);
+
+    for (auto&& [entity, position, kinematics, hitbox] : bodies(registry).each()) {
+      auto expected = proximity_range;
+      for (auto&& [other, other_position, other_kinematics, other_hitbox] : bodies(registry).each())
+        if (other != entity) expected = std::min(expected, physics::length(norm2(other_position - position)));
+      auto column = registry.get<FeatureColumn>(entity).index;
+      REQUIRE(feature_matrix(Feature::nearest_distance, column) == Approx(expected.count()));
+    }
+  }
+
+  SECTION("Après un déplacement, la grille reconstruite suit les nouvelles positions") {
+    for (auto&& [entity, position, kinematics, hitbox] : bodies(registry).each())
+      position = pick_position(rnd_engine);
+    update_broad_phase(registry);
+
+    auto center = pick_position(rnd_engine);
+    std::vector<entt::entity> near;
+    broad_phase.for_each_near(center, 1_q_m, [&](const auto& body) { near.push_back(body.entity); });
+    std::ranges::sort(near);
+    REQUIRE(near == find_near(registry, center, 1_q_m));
+  }
+}
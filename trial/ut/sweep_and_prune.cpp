@@ -0,0 +1,121 @@
+#include <catch.hpp>
+#include "../sweep_and_prune.hpp"
+
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "../trial.hpp"
+
+Setpoint dont_move(entt::entity, entt::registry&) {
+  return { .speed = 0_q_m_per_s, .angular_speed = 0_q_rad_per_s };
+}
+
+using Positions = std::map<entt::entity, Position>;
+
+//
+Positions get_positions(entt::registry& registry) {
+  Positions positions;
+  for (auto&& [entity, position, kinematics, hitbox] : bodies(registry).each())
+    positions[entity] = position;
+  return positions;
+}
+
+// Paires de robots qui se touchent pendant leur déplacement depuis 'starts',
+// par un test de toutes les paires
+std::vector<std::pair<entt::entity, entt::entity>> find_all_contacts(entt::registry& registry,
+                                                                     Positions& starts) {
+  std::vector<std::pair<entt::entity, entt::entity>> pairs;
+  auto group = bodies(registry);
+  for (auto&& [lhs, lhs_position, lhs_kinematics, lhs_hitbox] : group.each())
+    for (auto&& [rhs, rhs_position, rhs_kinematics, rhs_hitbox] : group.each())
+      if (lhs < rhs && lhs_hitbox.get_impact_fraction(rhs_hitbox, starts[rhs] - starts[lhs],
+                                                      rhs_position - lhs_position))
+        pairs.emplace_back(lhs, rhs);
+  std::ranges::sort(pairs);
+  return pairs;
+}
+
+//
+std::vector<std::pair<entt::entity, entt::entity>> get_pairs(const SweepAndPrune& sweep_and_prune) {
+  std::vector<std::pair<entt::entity, entt::entity>> pairs;
+  for (const auto& contact : sweep_and_prune.get_contacts()) pairs.emplace_back(contact.first, contact.second);
+  return pairs;
+}
+
+TEST_CASE("SweepAndPrune : trouver tous les contacts entre robots") {
+  TrialContext trial_context;
+  auto& registry = trial_context.prepare({
+    .playground {0_q_m, 0_q_m, 4_q_m, 4_q_m},
+    .foe_nb = 0,
+    .seed = 1337,
+    .dt = 0.1_q_s,
+    .time_limit = 10_q_s
+  });
+  RobotFeatures robot_features { .hitbox {10_q_cm}, .strategy_ftor = dont_move };
+  for (int i = 0; i < 300; i++) create_robot(registry, robot_features, false);
+
+  auto& sweep_and_prune = registry.ctx_or_set<SweepAndPrune>();
+  sweep_and_prune.reset(registry);
+  update_contacts(registry);
+
+  std::mt19937 rnd_engine(42);
+  std::uniform_real_distribution<physics::numeric> pick_step(-0.05, 0.05);
+  auto move_robots = [&] {
+    for (auto&& [entity, position, kinematics, hitbox] : bodies(registry).each()) {
+      position.x += physics::length(pick_step(rnd_engine));
+      position.y += physics::length(pick_step(rnd_engine));
+    }
+  };
+
+  SECTION("Les contacts trouvés sont ceux d'un test de toutes les paires, y "
+          "compris après plusieurs déplacements") {
+    auto starts = get_positions(registry);
+    REQUIRE_FALSE(sweep_and_prune.get_contacts().empty());
+    REQUIRE(get_pairs(sweep_and_prune) == find_all_contacts(registry, starts));
+    for (int i = 0; i < 20; i++) {
+      starts = get_positions(registry);
+      move_robots();
+      update_contacts(registry);
+      REQUIRE(get_pairs(sweep_and_prune) == find_all_contacts(registry, starts));
+    }
+  }
+
+  SECTION("Un contact qui dure garde l'instant où il a commencé") {
+    auto first_contacts = sweep_and_prune.get_contacts();
+    REQUIRE(sweep_and_prune.get_new_contacts_nb() == first_contacts.size());
+
+    update_contacts(registry);
+    REQUIRE(sweep_and_prune.get_new_contacts_nb() == 0);
+    REQUIRE(sweep_and_prune.get_contacts().size() == first_contacts.size());
+    for (const auto& contact : sweep_and_prune.get_contacts())
+      REQUIRE(contact.time == first_contacts.front().time);
+  }
+
+  SECTION("Les robots créés après une mise à jour sont pris en compte") {
+    for (int i = 0; i < 100; i++) create_robot(registry, robot_features, false);
+    auto starts = get_positions(registry);
+    update_contacts(registry);
+    REQUIRE(get_pairs(sweep_and_prune) == find_all_contacts(registry, starts));
+  }
+
+  SECTION("Deux robots qui se croisent pendant un pas sont en contact, même "
+          "s'ils sont séparés au début et à la fin du pas") {
+    registry.clear();
+    auto lhs = create_robot(registry, robot_features, false);
+    auto rhs = create_robot(registry, robot_features, false);
+    registry.replace<Position>(lhs, Position(1_q_m, 2_q_m));
+    registry.replace<Position>(rhs, Position(3_q_m, 2_q_m));
+    sweep_and_prune.reset(registry);
+
+    registry.replace<Position>(lhs, Position(3_q_m, 2_q_m));
+    registry.replace<Position>(rhs, Position(1_q_m, 2_q_m));
+    REQUIRE_FALSE(registry.get<Hitbox>(lhs).is_intersecting(registry.get<Hitbox>(rhs), Position(2_q_m, 0_q_m)));
+    update_contacts(registry);
+
+    // Les robots se touchent lorsqu'ils ont parcouru 0.9 m chacun
+    REQUIRE(sweep_and_prune.get_contacts().size() == 1);
+    REQUIRE(sweep_and_prune.get_contacts().front().time.count() == Approx(0.1 * 0.45));
+  }
+}
@@ -0,0 +1,82 @@
+#include <catch.hpp>
+#include "../component/task.hpp"
+
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+#include "../entity/robot_features.hpp"
+#include "../mechanic.hpp"
+#include "../trial_context.hpp"
+
+// Compter les allocations dynamiques du programme
+size_t allocations_nb = 0;
+
+void* operator new(size_t size) {
+  allocations_nb++;
+  if (auto pointer = std::malloc(size)) return pointer;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  std::free(pointer);
+}
+
+Setpoint dont_move(entt::entity, entt::registry&) {
+  return { .speed = 0_q_m_per_s, .angular_speed = 0_q_rad_per_s };
+}
+
+double sin_delta(entt::entity entity, entt::registry& registry) {
+  const auto& goal = get_goal(entity, registry);
+  return sin(atan(registry.get<Position>(entity) - goal) - registry.get<Kinematics>(entity).direction);
+}
+
+double distance_to_goal(entt::entity entity, entt::registry& registry) {
+  return norm2(registry.get<Position>(entity) - get_goal(entity, registry)).count();
+}
+
+TEST_CASE("Task : lire et mettre à jour l'objectif d'un robot sans copie ni allocation") {
+  TrialContext trial_context;
+  auto& registry = trial_context.prepare({
+    .playground {0_q_m, 0_q_m, 5_q_m, 5_q_m},
+    .foe_nb = 0,
+    .seed = 1337,
+    .dt = 0.1_q_s,
+    .time_limit = 10_q_s
+  });
+  RobotFeatures robot_features { .hitbox {10_q_cm}, .strategy_ftor = dont_move };
+  auto robot = create_robot(registry, robot_features, false);
+  registry.ctx_or_set<entt::entity>(robot) = robot;
+
+  SECTION("Une tâche ne contient que l'identifiant de l'objectif") {
+    REQUIRE(sizeof(Task) == sizeof(entt::entity));
+    REQUIRE(std::is_trivially_copyable_v<Task>);
+  }
+
+  SECTION("'get_goal' donne accès à la position de l'objectif stockée dans le "
+          "registre, et non à une copie") {
+    auto task_entity = registry.get<Task>(robot).get_entity();
+    REQUIRE(&get_goal(robot, registry) == &registry.get<Position>(task_entity));
+  }
+
+  SECTION("Les fetchers et la mise à jour des tâches n'allouent pas de mémoire, "
+          "y compris lorsqu'un nouvel objectif est tiré") {
+    double checksum = 0;
+    auto   reached_nb = 0;
+    auto   before = allocations_nb;
+    for (int i = 0; i < 100; i++) {
+      checksum += sin_delta(robot, registry) + distance_to_goal(robot, registry);
+      registry.replace<Position>(robot, get_goal(robot, registry));
+      update_tasks(registry);
+      reached_nb += registry.ctx<Outcome>() == Outcome::goal_reached;
+      registry.ctx<Outcome>() = Outcome::none;
+    }
+    REQUIRE(allocations_nb == before);
+    REQUIRE(reached_nb == 100);
+    REQUIRE(std::isfinite(checksum));
+  }
+}
@@ -8,7 +8,7 @@
 #include "ltl/Range/Filter.h"
 
 auto get_delta(entt::entity entity, entt::registry& registry, const Position& translation) {
-  auto direction = registry.get<physics::angle>(entity);
+  auto direction = registry.get<Kinematics>(entity).direction;
   auto direction_setpoint = atan(translation);
   return sin(direction_setpoint - direction);
 }
@@ -35,7 +35,7 @@ Setpoint collide_with_candidate(entt::entity entity, entt::registry& registry) {
 Setpoint collide_with_anyone(entt::entity entity, entt::registry& registry) {
   auto candidate = registry.ctx<entt::entity>();
   auto position = registry.get<Position>(candidate);
-  auto translations = registry.group<Position>(entt::get_t<Task>()).each()
+  auto translations = registry.view<Position, Task>().each()
                     | ltl::filter([entity](const auto& tuple) { return std::get<0>(tuple) != entity; })
                     | ltl::map([position](const auto& tuple) { return std::get<1>(tuple) - position; });
   auto compare_vector = [](const auto& lhs, const auto& rhs) { return norm2(lhs) < norm2(rhs); };
@@ -50,9 +50,8 @@ Setpoint collide_with_anyone(entt::entity entity, entt::registry& registry) {
 }
 
 Setpoint seek_goal(entt::entity entity, entt::registry& registry) {
-  auto task = registry.get<Task>(entity);
-  auto position = registry.get<Position>(entity);
-  auto goal = registry.get<Position>(task.get_entity());
+  const auto& position = registry.get<Position>(entity);
+  const auto& goal = get_goal(entity, registry);
   auto delta = get_delta(entity, registry, goal - position);
   return {
     .speed = 5_q_m_per_s / (1 + 10 * std::abs(delta)),
@@ -219,3 +218,85 @@ TEST_CASE("perform_trial : réccupérer l'issue de la simulation", "[outcome]")
     REQUIRE(outcome == Outcome::goal_reached);
   }
 }
+
+TEST_CASE("perform_trial : réutiliser le registre d'une épreuve à l'autre", "[context]") {
+  TrialParameters trial_parameters {
+    .playground {0_q_m, 0_q_m, 5_q_m, 4_q_m},
+    .foe_nb = 2,
+    .seed = 0,
+    .dt = 10_q_ms,
+    .time_limit = 5_q_s
+  };
+  TrialContext trial_context;
+
+  SECTION("Une épreuve menée dans un registre déjà utilisé a la même issue que "
+          "dans un registre neuf") {
+    for (int64_t seed = 0; seed < 20; seed++) {
+      trial_parameters.seed = seed;
+      trial_parameters.foe_nb = seed % 4;
+      TrialContext fresh_context;
+      auto expected = perform_trial(fresh_context, trial_parameters, worker_features, shark_features);
+      auto results = perform_trial(trial_context, trial_parameters, worker_features, shark_features);
+      REQUIRE(results.outcome == expected.outcome);
+      REQUIRE(results.time == expected.time);
+      REQUIRE(results.best_distance == expected.best_distance);
+      REQUIRE(trial_context.get_registry().alive() == 2 * (trial_parameters.foe_nb + 1));
+    }
+  }
+
+  SECTION("Les adversaires partagent une même stratégie, et les robots dont les "
+          "stratégies ont le même type sont pilotés par un même système") {
+    using StrategyFtor = Setpoint(*)(entt::entity, entt::registry&);
+    trial_parameters.foe_nb = 5;
+    perform_trial(trial_context, trial_parameters, worker_features, shark_features);
+
+    auto& registry = trial_context.get_registry();
+    REQUIRE(registry.ctx<StrategyPool<StrategyFtor>>().strategy_ftors.size() == 2);
+    REQUIRE(registry.ctx<StrategyDispatch>().systems.size() == 1);
+    REQUIRE(registry.view<StrategyRef<StrategyFtor>>().size() == 6);
+  }
+
+  SECTION("Sans adversaire, la stratégie des adversaires n'est pas stockée") {
+    using StrategyFtor = Setpoint(*)(entt::entity, entt::registry&);
+    trial_parameters.foe_nb = 0;
+    perform_trial(trial_context, trial_parameters, worker_features, shark_features);
+
+    REQUIRE(trial_context.get_registry().ctx<StrategyPool<StrategyFtor>>().strategy_ftors.size() == 1);
+  }
+}
+
+// Stratégie qui compte ses décisions dans sa mémoire de travail
+struct CountingStrategy {
+  int make_workspace() const { return 0; }
+
+  Setpoint decide(entt::entity, entt::registry&, int& decisions_nb) const {
+    decisions_nb++;
+    return { .speed = physics::speed(decisions_nb), .angular_speed = 0_q_rad_per_s };
+  }
+
+  Setpoint operator()(entt::entity entity, entt::registry& registry) const {
+    int decisions_nb = make_workspace();
+    return decide(entity, registry, decisions_nb);
+  }
+};
+
+TEST_CASE("set_setpoints : donner à chaque robot sa propre mémoire de travail") {
+  TrialContext trial_context;
+  auto& registry = trial_context.prepare({
+    .playground {0_q_m, 0_q_m, 5_q_m, 4_q_m},
+    .foe_nb = 0,
+    .seed = 0,
+    .dt = 10_q_ms,
+    .time_limit = 5_q_s
+  });
+  RobotFeatures counting_features { .hitbox {10_q_cm}, .strategy_ftor = CountingStrategy() };
+  auto strategy_ref = add_strategy(registry, counting_features.strategy_ftor);
+  for (int i = 0; i < 3; i++) create_robot(registry, counting_features, false, strategy_ref);
+
+  SECTION("Les robots qui partagent une stratégie ne partagent pas l'état de leur "
+          "mémoire de travail") {
+    for (int i = 0; i < 4; i++) set_setpoints(registry);
+    for (auto&& [entity, kinematics] : registry.view<const Kinematics>().each())
+      REQUIRE(kinematics.speed == physics::speed(4));
+  }
+}